@@ -0,0 +1,619 @@
+//==============================================================================
+// AbyssVerbBench — DSPステージ単体と処理グラフ全体のベンチマーク
+//
+// 各ステージをブロックサイズ × サンプルレートの組み合わせで計測し、
+// ns/sample・リアルタイム倍率・1コアあたりのインスタンス数を出力する。
+// --json で機械可読な結果を出力（CIでのコミット間比較用）
+// ABYSSVERB_PROFILING ビルドでは処理グラフ全体のケースに段別の内訳（ns/sample と負荷）も付く
+//==============================================================================
+#include "dsp/AbyssVerbEngine.h"
+#include "dsp/FastRandom.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+
+// 1ブロック分の処理。ステージ単体ではL側のみを使う
+using Kernel = std::function<void(const float* inL, const float* inR, float* outL, float* outR, int n)>;
+
+struct Benchmark
+{
+    std::string name;
+    std::function<Kernel(double sampleRate, int blockSize)> make;
+};
+
+struct Result
+{
+    std::string name;
+    int blockSize = 0;
+    double sampleRate = 0.0;
+    long long samples = 0;
+    double nsPerSample = 0.0;      // 反復の中央値
+    double nsPerSampleMin = 0.0;
+    double realtimeFactor = 0.0;   // 処理できる音声時間 / 実時間
+    long long instancesPerCore = 0;
+#if ABYSSVERB_PROFILING
+    bool hasProfile = false;       // 処理グラフ全体のケースだけ
+    ProfileStatistics::Summary profile;
+#endif
+};
+
+struct Options
+{
+    std::vector<int> blockSizes { 16, 64, 256, 1024, 4096 };
+    std::vector<double> sampleRates { 44100.0, 48000.0, 96000.0, 192000.0 };
+    double minTime = 0.1;   // 1反復あたりの最短計測時間 [s]
+    int repetitions = 3;
+    std::string filter;
+    bool json = false;
+    std::string jsonPath;   // 空なら標準出力
+};
+
+// 最適化で計算が消されないよう、出力を揮発性変数に流す
+volatile float benchSink = 0.0f;
+
+float paramDefault(Param p) { return getParamSpec(p).defaultValue; }
+
+#if ABYSSVERB_PROFILING
+// 計測中のケースのエンジン（処理グラフ全体のケースが make で設定する）。計測中に段別の記録を読み出す
+AbyssVerbEngine* profiledEngine = nullptr;
+#endif
+
+//==============================================================================
+// ベンチマーク定義
+//==============================================================================
+std::vector<Benchmark> makeBenchmarks()
+{
+    std::vector<Benchmark> list;
+
+    list.push_back({ "conditioner", [](double sr, int) -> Kernel
+    {
+        auto stage = std::make_shared<ViolinInputConditioner>();
+        stage->prepare(sr);
+        stage->setParameters(paramDefault(Param::piezoCorrect), paramDefault(Param::bodyResonance),
+                             paramDefault(Param::brightness));
+        return [stage](const float* in, const float*, float* out, float*, int n)
+        {
+            stage->process(in, out, n);
+        };
+    }});
+
+    list.push_back({ "envelope", [](double sr, int) -> Kernel
+    {
+        auto stage = std::make_shared<EnvelopeFollower>();
+        stage->prepare(sr);
+        stage->setParameters(5.0f, 150.0f);
+        return [stage](const float* in, const float*, float* out, float*, int n)
+        {
+            stage->process(in, out, n);
+        };
+    }});
+
+    // リバーブ: 残響時間とモジュレーション深さの組み合わせ
+    const float decays[] = { 2.0f, 8.0f, 30.0f };
+    const float modDepths[] = { 0.0f, 0.6f, 2.0f };
+    for (float decay : decays)
+        for (float modDepth : modDepths)
+        {
+            char name[64];
+            std::snprintf(name, sizeof(name), "fdn/decay=%g/mod=%g", decay, modDepth);
+            list.push_back({ name, [decay, modDepth](double sr, int block) -> Kernel
+            {
+                auto stage = std::make_shared<AbyssFDNReverb>();
+                stage->prepare(sr, block);
+                stage->setParameters(decay, paramDefault(Param::reverbDampHigh), paramDefault(Param::reverbDampLow),
+                                     modDepth, paramDefault(Param::reverbModRate));
+                auto envelope = std::make_shared<std::vector<float>>(static_cast<size_t>(block), 0.5f);
+                return [stage, envelope](const float* in, const float*, float* out, float*, int n)
+                {
+                    stage->process(in, envelope->data(), out, n);
+                };
+            }});
+        }
+
+    // 消失ディレイ: 消失率 0〜0.7
+    const float vanishRates[] = { 0.0f, 0.35f, 0.7f };
+    for (float vanishRate : vanishRates)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "delay/vanish=%g", vanishRate);
+        list.push_back({ name, [vanishRate](double sr, int block) -> Kernel
+        {
+            auto stage = std::make_shared<VanishingDelay>();
+            stage->prepare(sr, block);
+            stage->setParameters(paramDefault(Param::delayTime), paramDefault(Param::delayFeedback), vanishRate,
+                                 paramDefault(Param::degradeAmount), paramDefault(Param::driftAmount),
+                                 paramDefault(Param::detuneAmount));
+            auto envelope = std::make_shared<std::vector<float>>(static_cast<size_t>(block), 0.5f);
+            return [stage, envelope](const float* in, const float*, float* out, float*, int n)
+            {
+                stage->process(in, envelope->data(), out, n);
+            };
+        }});
+    }
+
+    // 初期反射: 指数減衰ノイズの IR（胴鳴り程度の 50ms から上限の 1s まで）
+    const double irSeconds[] = { 0.05, 0.25, 1.0 };
+    for (double seconds : irSeconds)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "early-reflections/ir=%gs", seconds);
+        list.push_back({ name, [seconds](double sr, int block) -> Kernel
+        {
+            ImpulseResponse ir;
+            ir.sampleRate = sr;
+            ir.channels.emplace_back(static_cast<size_t>(sr * seconds));
+            FastRandom random(7);
+            auto& impulse = ir.channels[0];
+            for (size_t i = 0; i < impulse.size(); ++i)
+                impulse[i] = (random.nextFloat() * 2.0f - 1.0f)
+                           * std::exp(-6.9f * static_cast<float>(i) / static_cast<float>(impulse.size()));
+
+            auto stage = std::make_shared<EarlyReflections>();
+            stage->setImpulseResponse(std::move(ir));
+            stage->prepare(sr, block);
+            return [stage](const float* in, const float*, float* out, float*, int n)
+            {
+                stage->beginBlock(n);
+                stage->process(0, in, out, n);
+            };
+        }});
+    }
+
+    // 補間品質ごとの変調読み出し（既定パラメーターのリバーブと消失ディレイ）
+    const InterpolationQuality qualities[] = { InterpolationQuality::linear, InterpolationQuality::hermite,
+                                               InterpolationQuality::lagrange, InterpolationQuality::sinc };
+    for (auto quality : qualities)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "interp=%s/fdn", FractionalDelay::qualityName(quality));
+        list.push_back({ name, [quality](double sr, int block) -> Kernel
+        {
+            auto stage = std::make_shared<AbyssFDNReverb>();
+            stage->prepare(sr, block);
+            stage->setInterpolation(quality);
+            stage->setParameters(paramDefault(Param::reverbDecay), paramDefault(Param::reverbDampHigh),
+                                 paramDefault(Param::reverbDampLow), paramDefault(Param::reverbModDepth),
+                                 paramDefault(Param::reverbModRate));
+            auto envelope = std::make_shared<std::vector<float>>(static_cast<size_t>(block), 0.5f);
+            return [stage, envelope](const float* in, const float*, float* out, float*, int n)
+            {
+                stage->process(in, envelope->data(), out, n);
+            };
+        }});
+
+        std::snprintf(name, sizeof(name), "interp=%s/delay", FractionalDelay::qualityName(quality));
+        list.push_back({ name, [quality](double sr, int block) -> Kernel
+        {
+            auto stage = std::make_shared<VanishingDelay>();
+            stage->prepare(sr, block);
+            stage->setInterpolation(quality);
+            stage->setParameters(paramDefault(Param::delayTime), paramDefault(Param::delayFeedback),
+                                 paramDefault(Param::vanishRate), paramDefault(Param::degradeAmount),
+                                 paramDefault(Param::driftAmount), paramDefault(Param::detuneAmount));
+            auto envelope = std::make_shared<std::vector<float>>(static_cast<size_t>(block), 0.5f);
+            return [stage, envelope](const float* in, const float*, float* out, float*, int n)
+            {
+                stage->process(in, envelope->data(), out, n);
+            };
+        }});
+    }
+
+    // 出力段（DC除去 + ソフトリミッター + ミックス）。リミッターが常に効く +12dB の入力で計測
+    auto outputStage = [](const DspKernels& kernels)
+    {
+        return [&kernels](double, int block) -> Kernel
+        {
+            auto dcBlocker = std::make_shared<DcBlocker>();
+            auto wet = std::make_shared<std::vector<float>>(static_cast<size_t>(block));
+            return [&kernels, dcBlocker, wet](const float* in, const float*, float* out, float*, int n)
+            {
+                float* w = wet->data();
+                for (int i = 0; i < n; ++i)
+                    w[i] = in[i] * 4.0f;
+                dcBlocker->process(w, w, n);
+                kernels.softClip(w, n);
+                kernels.mix(in, w, out, { nullptr, 0.45f }, n);
+            };
+        };
+    };
+    list.push_back({ "output-stage", outputStage(SimdDispatch::select()) });
+
+    // 命令セット別カーネル: この CPU で使える版ごとに、既定パラメーターのリバーブと
+    // 出力段を同じ条件で計測する（ABYSSVERB_SIMD による選択とは無関係）
+    const SimdVariant simdVariants[] = { SimdVariant::scalar, SimdVariant::sse2, SimdVariant::neon,
+                                         SimdVariant::avx2, SimdVariant::avx512 };
+    for (auto simd : simdVariants)
+    {
+        if (! SimdDispatch::isAvailable(simd))
+            continue;
+
+        const DspKernels& kernels = SimdDispatch::get(simd);
+        const std::string prefix = std::string("simd=") + SimdDispatch::variantName(simd) + "/";
+
+        list.push_back({ prefix + "fdn", [&kernels](double sr, int block) -> Kernel
+        {
+            auto stage = std::make_shared<AbyssFDNReverb>();
+            stage->prepare(sr, block);
+            stage->setKernels(kernels);
+            stage->setParameters(paramDefault(Param::reverbDecay), paramDefault(Param::reverbDampHigh),
+                                 paramDefault(Param::reverbDampLow), paramDefault(Param::reverbModDepth),
+                                 paramDefault(Param::reverbModRate));
+            auto envelope = std::make_shared<std::vector<float>>(static_cast<size_t>(block), 0.5f);
+            return [stage, envelope](const float* in, const float*, float* out, float*, int n)
+            {
+                stage->process(in, envelope->data(), out, n);
+            };
+        }});
+
+        list.push_back({ prefix + "output-stage", outputStage(kernels) });
+    }
+
+    // 処理グラフ全体（ステレオ、ns/sample はステレオ1フレームあたり）
+    // parallel: L/R チェーンを2スレッドで処理（PARALLEL_MIN_BLOCK 未満のブロックは直列のまま）
+    struct EngineVariant { const char* name; bool trueStereo; bool parallel; };
+    const EngineVariant variants[] = { { "engine/dual-mono",          false, false },
+                                       { "engine/true-stereo",        true,  false },
+                                       { "engine/dual-mono-parallel", false, true  } };
+    for (const auto& variant : variants)
+    {
+        list.push_back({ variant.name, [variant](double sr, int block) -> Kernel
+        {
+            auto params = ParamSnapshot::defaults();
+            params[Param::trueStereo] = variant.trueStereo ? 1.0f : 0.0f;
+
+            auto engine = std::make_shared<AbyssVerbEngine>();
+            engine->prepare(sr, block, params);
+            engine->setParallelChannels(variant.parallel);
+#if ABYSSVERB_PROFILING
+            profiledEngine = engine.get();
+#endif
+            return [engine, params](const float* inL, const float* inR, float* outL, float* outR, int n)
+            {
+                engine->process(inL, inR, outL, outR, n, params);
+            };
+        }});
+    }
+
+    // 入力が無音で残響も減衰しきったインスタンス（スリープ中のコスト）
+    list.push_back({ "engine/idle", [](double sr, int block) -> Kernel
+    {
+        const auto params = ParamSnapshot::defaults();
+        auto engine = std::make_shared<AbyssVerbEngine>();
+        engine->prepare(sr, block, params);
+
+        auto silence = std::make_shared<std::vector<float>>(static_cast<size_t>(block), 0.0f);
+        std::vector<float> scratchL(static_cast<size_t>(block)), scratchR(static_cast<size_t>(block));
+        for (long long done = 0; done < static_cast<long long>(sr) && ! engine->isSleeping(); done += block)
+            engine->process(silence->data(), silence->data(), scratchL.data(), scratchR.data(), block, params);
+#if ABYSSVERB_PROFILING
+        profiledEngine = engine.get();
+#endif
+
+        return [engine, params, silence](const float*, const float*, float* outL, float* outR, int n)
+        {
+            engine->process(silence->data(), silence->data(), outL, outR, n, params);
+        };
+    }});
+
+    return list;
+}
+
+//==============================================================================
+// 計測
+//==============================================================================
+// バイオリンらしい入力: 倍音の多いノコギリ波 + 弓のノイズ、1秒周期の弓の強弱
+std::vector<float> makeSource(double sampleRate, float detune)
+{
+    std::vector<float> source(static_cast<size_t>(sampleRate));
+    const double freq = 440.0 * detune;
+    std::uint32_t noise = 0x12345678u;
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const double t = static_cast<double>(i) / sampleRate;
+        const double saw = 2.0 * (t * freq - std::floor(t * freq + 0.5));
+        noise ^= noise << 13; noise ^= noise >> 17; noise ^= noise << 5;
+        const double bowNoise = (static_cast<double>(noise) / 4294967295.0 - 0.5) * 0.05;
+        const double bow = 0.5 - 0.45 * std::cos(2.0 * DspConstants<double>::pi * t);
+        source[i] = static_cast<float>((saw * 0.3 + bowNoise) * bow);
+    }
+    return source;
+}
+
+Result measure(const Benchmark& bench, double sampleRate, int blockSize, const Options& options)
+{
+#if ABYSSVERB_PROFILING
+    profiledEngine = nullptr;
+    ProfileStatistics profile;
+    ProfileFrame frame;
+#endif
+    const Kernel kernel = bench.make(sampleRate, blockSize);
+
+    const auto sourceL = makeSource(sampleRate, 1.0f);
+    const auto sourceR = makeSource(sampleRate, 1.003f);
+    std::vector<float> outL(static_cast<size_t>(blockSize)), outR(static_cast<size_t>(blockSize));
+
+    const int sourceLength = static_cast<int>(sourceL.size());
+    int readPos = 0;
+    auto runBlock = [&]
+    {
+        if (readPos + blockSize > sourceLength)
+            readPos = 0;
+        kernel(sourceL.data() + readPos, sourceR.data() + readPos, outL.data(), outR.data(), blockSize);
+        benchSink = benchSink + outL[0] + outR[static_cast<size_t>(blockSize - 1)];
+        readPos += blockSize;
+#if ABYSSVERB_PROFILING
+        // リングが溢れないよう毎ブロック読む（計測時間に含まれるが、1ブロック数十ns）
+        if (profiledEngine != nullptr)
+            while (profiledEngine->popProfileFrame(frame))
+                profile.add(frame);
+#endif
+    };
+
+    // ウォームアップ: 約0.1秒分の音声（キャッシュ・分岐予測・ディレイラインを温める）
+    for (long long done = 0; done < static_cast<long long>(sampleRate * 0.1); done += blockSize)
+        runBlock();
+#if ABYSSVERB_PROFILING
+    profile.reset();
+#endif
+
+    // 時刻取得のコストを薄めるため、約4096サンプルごとに経過時間を確認する
+    const int blocksPerCheck = std::max(1, 4096 / blockSize);
+    std::vector<double> nsPerSample;
+    long long totalSamples = 0;
+
+    for (int rep = 0; rep < std::max(1, options.repetitions); ++rep)
+    {
+        long long samples = 0;
+        const auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed {};
+
+        do
+        {
+            for (int b = 0; b < blocksPerCheck; ++b)
+                runBlock();
+            samples += static_cast<long long>(blocksPerCheck) * blockSize;
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+        while (elapsed.count() < options.minTime);
+
+        nsPerSample.push_back(elapsed.count() * 1.0e9 / static_cast<double>(samples));
+        totalSamples += samples;
+    }
+
+    std::sort(nsPerSample.begin(), nsPerSample.end());
+
+    Result result;
+    result.name = bench.name;
+    result.blockSize = blockSize;
+    result.sampleRate = sampleRate;
+    result.samples = totalSamples;
+    result.nsPerSample = nsPerSample[nsPerSample.size() / 2];
+    result.nsPerSampleMin = nsPerSample.front();
+    result.realtimeFactor = 1.0e9 / (result.nsPerSample * sampleRate);
+    result.instancesPerCore = static_cast<long long>(std::floor(result.realtimeFactor));
+#if ABYSSVERB_PROFILING
+    result.hasProfile = profiledEngine != nullptr;
+    result.profile = profile.summarize();
+    profiledEngine = nullptr;
+#endif
+    return result;
+}
+
+//==============================================================================
+// 出力
+//==============================================================================
+// prepare で各ステージが使う命令セット別カーネル（ABYSSVERB_SIMD で固定できる）
+const char* simdName()
+{
+    return SimdDispatch::variantName(SimdDispatch::select().variant);
+}
+
+std::string fullName(const Result& r)
+{
+    return r.name + "/block:" + std::to_string(r.blockSize)
+                  + "/sr:" + std::to_string(static_cast<int>(r.sampleRate));
+}
+
+void printTableHeader()
+{
+    std::printf("%-48s %12s %12s %12s %10s\n", "Benchmark", "ns/sample", "min ns/smp", "realtime x", "inst/core");
+    std::printf("%s\n", std::string(98, '-').c_str());
+}
+
+void printTableRow(const Result& r)
+{
+    std::printf("%-48s %12.2f %12.2f %12.1f %10lld\n", fullName(r).c_str(),
+                r.nsPerSample, r.nsPerSampleMin, r.realtimeFactor, r.instancesPerCore);
+#if ABYSSVERB_PROFILING
+    // 段別の内訳（ns/sample）と、ブロック長に対する負荷の p99 / 最大
+    if (r.hasProfile)
+    {
+        std::printf("    ");
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            std::printf("%s %.1f  ", profileStageName(static_cast<ProfileStage>(s)),
+                        r.profile.stageNsPerSample[static_cast<size_t>(s)]);
+        std::printf("| load p99 %.2f%% max %.2f%%\n", r.profile.total.p99 * 100.0, r.profile.total.max * 100.0);
+    }
+#endif
+    std::fflush(stdout);
+}
+
+bool writeJson(const std::vector<Result>& results, const Options& options)
+{
+    FILE* out = options.jsonPath.empty() ? stdout : std::fopen(options.jsonPath.c_str(), "w");
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "cannot open %s for writing\n", options.jsonPath.c_str());
+        return false;
+    }
+
+    char date[32] = {};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": \"%s\",\n", date);
+    std::fprintf(out, "    \"simd\": \"%s\",\n", simdName());
+#ifdef NDEBUG
+    std::fprintf(out, "    \"build_type\": \"release\",\n");
+#else
+    std::fprintf(out, "    \"build_type\": \"debug\",\n");
+#endif
+    std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(out, "    \"min_time\": %g,\n", options.minTime);
+    std::fprintf(out, "    \"repetitions\": %d\n  },\n", options.repetitions);
+    std::fprintf(out, "  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"stage\": \"%s\", \"block_size\": %d, \"sample_rate\": %d, "
+                          "\"samples\": %lld, \"ns_per_sample\": %.4f, \"ns_per_sample_min\": %.4f, "
+                          "\"realtime_factor\": %.3f, \"instances_per_core\": %lld",
+                     fullName(r).c_str(), r.name.c_str(), r.blockSize, static_cast<int>(r.sampleRate),
+                     r.samples, r.nsPerSample, r.nsPerSampleMin, r.realtimeFactor, r.instancesPerCore);
+#if ABYSSVERB_PROFILING
+        if (r.hasProfile)
+            std::fprintf(out, ", \"profile\": %s", ProfileStatistics::toJson(r.profile).c_str());
+#endif
+        std::fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+    if (out != stdout)
+        std::fclose(out);
+    return true;
+}
+
+//==============================================================================
+// コマンドライン
+//==============================================================================
+template <typename T>
+std::vector<T> parseList(const std::string& text)
+{
+    std::vector<T> values;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t comma = text.find(',', pos);
+        if (comma == std::string::npos)
+            comma = text.size();
+        values.push_back(static_cast<T>(std::atof(text.substr(pos, comma - pos).c_str())));
+        pos = comma + 1;
+    }
+    return values;
+}
+
+void printUsage()
+{
+    std::printf("usage: AbyssVerbBench [options]\n"
+                "  --filter <text>          run only benchmarks whose name contains <text>\n"
+                "  --block-sizes <list>     comma separated block sizes (default 16,64,256,1024,4096)\n"
+                "  --sample-rates <list>    comma separated sample rates (default 44100,48000,96000,192000)\n"
+                "  --min-time <seconds>     minimum measured time per repetition (default 0.1)\n"
+                "  --repetitions <n>        repetitions per case, the median is reported (default 3)\n"
+                "  --json [path]            write JSON results to <path> or stdout\n"
+                "  --list                   list benchmark names and exit\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options, bool& listOnly)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+        if (arg == "--json")
+        {
+            options.json = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                options.jsonPath = argv[++i];
+        }
+        else if (arg == "--list")
+            listOnly = true;
+        else if (arg == "--help" || arg == "-h")
+            return false;
+        else if (const char* value = (arg == "--filter" || arg == "--block-sizes" || arg == "--sample-rates"
+                                      || arg == "--min-time" || arg == "--repetitions") ? next() : nullptr)
+        {
+            if (arg == "--filter")            options.filter = value;
+            else if (arg == "--block-sizes")  options.blockSizes = parseList<int>(value);
+            else if (arg == "--sample-rates") options.sampleRates = parseList<double>(value);
+            else if (arg == "--min-time")     options.minTime = std::atof(value);
+            else                              options.repetitions = std::atoi(value);
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    const bool valid = std::all_of(options.blockSizes.begin(), options.blockSizes.end(), [](int b) { return b > 0; })
+                    && std::all_of(options.sampleRates.begin(), options.sampleRates.end(), [](double s) { return s > 0.0; });
+    if (! valid)
+        std::fprintf(stderr, "block sizes and sample rates must be positive\n");
+    return valid;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    bool listOnly = false;
+    if (! parseOptions(argc, argv, options, listOnly))
+    {
+        printUsage();
+        return 1;
+    }
+
+    const auto benchmarks = makeBenchmarks();
+
+    if (listOnly)
+    {
+        for (const auto& bench : benchmarks)
+            std::printf("%s\n", bench.name.c_str());
+        return 0;
+    }
+
+    // JSON を標準出力に書く場合は表を出さない
+    const bool printTable = ! (options.json && options.jsonPath.empty());
+    if (printTable)
+    {
+        std::printf("AbyssVerbBench (simd: %s, min time %gs x %d)\n\n", simdName(), options.minTime, options.repetitions);
+        printTableHeader();
+    }
+
+    std::vector<Result> results;
+    for (const auto& bench : benchmarks)
+    {
+        if (! options.filter.empty() && bench.name.find(options.filter) == std::string::npos)
+            continue;
+
+        for (double sampleRate : options.sampleRates)
+            for (int blockSize : options.blockSizes)
+            {
+                results.push_back(measure(bench, sampleRate, blockSize, options));
+                if (printTable)
+                    printTableRow(results.back());
+            }
+    }
+
+    if (options.json && ! writeJson(results, options))
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "ImpulseResponseLoader.h"
+
+ImpulseResponseLoader::ImpulseResponseLoader(AbyssVerbEngine& engineToFeed)
+    : juce::Thread("AbyssVerb IR loader"), engine(engineToFeed)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+ImpulseResponseLoader::~ImpulseResponseLoader()
+{
+    stopThread(5000);
+}
+
+void ImpulseResponseLoader::load(const juce::File& file)
+{
+    {
+        const juce::ScopedLock lock(requestLock);
+        requestedFile = file;
+        hasRequest = true;
+    }
+    notify();
+}
+
+void ImpulseResponseLoader::run()
+{
+    while (! threadShouldExit())
+    {
+        juce::File file;
+        bool requested = false;
+        {
+            const juce::ScopedLock lock(requestLock);
+            requested = std::exchange(hasRequest, false);
+            file = requestedFile;
+        }
+
+        // notify は待つ前に来ても取りこぼさない（WaitableEvent がシグナル状態で残る）
+        if (! requested)
+        {
+            wait(-1);
+            continue;
+        }
+
+        // 読めなければ今の IR のまま
+        ImpulseResponse impulseResponse;
+        juce::String error;
+        if (file != juce::File() && ! readFile(file, impulseResponse, error))
+        {
+            DBG(error);
+            continue;
+        }
+
+        engine.setEarlyReflectionsImpulseResponse(std::move(impulseResponse));
+    }
+}
+
+bool ImpulseResponseLoader::readFile(const juce::File& file, ImpulseResponse& result, juce::String& error)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr)
+    {
+        error = file.getFullPathName() + " is not a readable audio file";
+        return false;
+    }
+
+    // 上限長を超える部分は使わない（リサンプル後に切り口をフェードさせるので少しだけ余分に読む）
+    const auto maxSamples = static_cast<juce::int64>(std::ceil(reader->sampleRate * EarlyReflections::MAX_LENGTH_SECONDS)) + 64;
+    const int length = static_cast<int>(juce::jmin(reader->lengthInSamples, maxSamples));
+    const int numChannels = juce::jmin(2, static_cast<int>(reader->numChannels));
+    if (length <= 0 || numChannels <= 0 || reader->sampleRate <= 0.0)
+    {
+        error = file.getFullPathName() + " contains no audio";
+        return false;
+    }
+
+    juce::AudioBuffer<float> buffer(numChannels, length);
+    if (! reader->read(&buffer, 0, length, 0, true, numChannels > 1))
+    {
+        error = "cannot read " + file.getFullPathName();
+        return false;
+    }
+
+    result.sampleRate = reader->sampleRate;
+    result.channels.assign(static_cast<size_t>(numChannels), {});
+    for (int ch = 0; ch < numChannels; ++ch)
+        result.channels[static_cast<size_t>(ch)].assign(buffer.getReadPointer(ch), buffer.getReadPointer(ch) + length);
+    return true;
+}
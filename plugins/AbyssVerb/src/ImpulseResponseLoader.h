@@ -0,0 +1,33 @@
+#pragma once
+#include <JuceHeader.h>
+#include "dsp/AbyssVerbEngine.h"
+
+//==============================================================================
+// 初期反射 IR のバックグラウンド読み込み
+// ファイルのデコードからリサンプル・分割FFTまでを専用スレッドで行い、完成した係数を
+// エンジンへ渡す（オーディオスレッドはロックも確保もしない）。
+// 読み込み中に次の要求が来たら、最後の要求だけを読む
+//==============================================================================
+class ImpulseResponseLoader : private juce::Thread
+{
+public:
+    explicit ImpulseResponseLoader(AbyssVerbEngine& engineToFeed);
+    ~ImpulseResponseLoader() override;
+
+    // 読み込み要求（メッセージスレッドから。空の File で解除）
+    void load(const juce::File& file);
+
+    // 音声ファイルを IR として読む（先頭2チャンネル、上限長まで）。オフラインツールと共通
+    static bool readFile(const juce::File& file, ImpulseResponse& result, juce::String& error);
+
+private:
+    void run() override;
+
+    AbyssVerbEngine& engine;
+
+    juce::CriticalSection requestLock;
+    juce::File requestedFile;
+    bool hasRequest = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImpulseResponseLoader)
+};
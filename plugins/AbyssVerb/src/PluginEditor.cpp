@@ -1,10 +1,77 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+//==============================================================================
+AbyssLookAndFeel::RotaryGeometry AbyssLookAndFeel::getGeometry(int width, int height)
+{
+    const auto bounds = juce::Rectangle<int>(width, height).toFloat().reduced(10.0f);
+    const float radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
+    const float lineWidth = juce::jmin(8.0f, radius * 0.5f);
+    return { bounds.getCentre(), radius - lineWidth * 0.5f, lineWidth };
+}
+
+const juce::Path& AbyssLookAndFeel::getTrackOutline(int width, int height, float startAngle, float endAngle)
+{
+    for (const auto& track : trackCache)
+        if (track.width == width && track.height == height
+            && track.startAngle == startAngle && track.endAngle == endAngle)
+            return track.outline;
+
+    // 寸法の組み合わせはノブの種類ぶんしかないが、リサイズを繰り返しても増え続けないように
+    if (trackCache.size() >= MAX_CACHED_TRACKS)
+        trackCache.clear();
+
+    const auto geometry = getGeometry(width, height);
+    juce::Path arc;
+    arc.addCentredArc(geometry.centre.x, geometry.centre.y, geometry.arcRadius, geometry.arcRadius,
+                      0.0f, startAngle, endAngle, true);
+
+    RotaryTrack track { width, height, startAngle, endAngle, {} };
+    juce::PathStrokeType(geometry.lineWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded)
+        .createStrokedPath(track.outline, arc);
+    trackCache.push_back(std::move(track));
+    return trackCache.back().outline;
+}
+
+void AbyssLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos,
+                                        float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider)
+{
+    const auto geometry = getGeometry(width, height);
+    const auto origin = juce::AffineTransform::translation(static_cast<float>(x), static_cast<float>(y));
+    const float toAngle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
+
+    // 軌道はキャッシュした輪郭を塗るだけ
+    g.setColour(slider.findColour(juce::Slider::rotarySliderOutlineColourId));
+    g.fillPath(getTrackOutline(width, height, rotaryStartAngle, rotaryEndAngle), origin);
+
+    // 値の弧は値ごとに変わるのでその都度（ドラッグ中のノブだけが描き直される）
+    if (slider.isEnabled())
+    {
+        juce::Path valueArc;
+        valueArc.addCentredArc(geometry.centre.x, geometry.centre.y, geometry.arcRadius, geometry.arcRadius,
+                               0.0f, rotaryStartAngle, toAngle, true);
+        g.setColour(slider.findColour(juce::Slider::rotarySliderFillColourId));
+        g.strokePath(valueArc, juce::PathStrokeType(geometry.lineWidth, juce::PathStrokeType::curved,
+                                                    juce::PathStrokeType::rounded), origin);
+    }
+
+    const float thumbWidth = geometry.lineWidth * 2.0f;
+    const auto thumb = geometry.centre.translated(static_cast<float>(x), static_cast<float>(y))
+                     + juce::Point<float>(std::cos(toAngle - juce::MathConstants<float>::halfPi),
+                                          std::sin(toAngle - juce::MathConstants<float>::halfPi)) * geometry.arcRadius;
+    g.setColour(slider.findColour(juce::Slider::thumbColourId));
+    g.fillEllipse(juce::Rectangle<float>(thumbWidth, thumbWidth).withCentre(thumb));
+}
+
+//==============================================================================
+
 AbyssVerbAudioProcessorEditor::AbyssVerbAudioProcessorEditor(AbyssVerbAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p)
 {
-    setSize(900, 620);
+    // 背景画像が全面を覆うので、親やホストの窓を描き直させない
+    setOpaque(true);
+    setLookAndFeel(&lookAndFeel.get());
+    setSize(900, 720);
 
     auto warm = juce::Colour(0xFFB87A4B);   // 木の温もり
     auto deep = juce::Colour(0xFF3A7CA5);   // 深い青
@@ -22,6 +89,12 @@ AbyssVerbAudioProcessorEditor::AbyssVerbAudioProcessorEditor(AbyssVerbAudioProce
     setupKnob(dampLowKnob,  "reverbDampLow",  "LOW WARMTH",    deep);
     setupKnob(shimmerKnob,  "reverbModDepth", "SHIMMER",       deep);
     setupKnob(swayKnob,     "reverbModRate",  "SWAY",          deep);
+    setupKnob(earlyKnob,    "earlyLevel",     "EARLY",         deep);
+
+    // リバーブの帯域別減衰
+    setupKnob(lowDepthKnob,   "reverbLowDecay",  "LOW DEPTH",   deep);
+    setupKnob(highDepthKnob,  "reverbHighDecay", "HIGH DEPTH",  deep);
+    setupKnob(depthSplitKnob, "reverbCrossover", "DEPTH SPLIT", deep);
 
     // ディレイ
     setupKnob(echoTimeKnob,    "delayTime",      "ECHO TIME",     fade);
@@ -36,9 +109,103 @@ AbyssVerbAudioProcessorEditor::AbyssVerbAudioProcessorEditor(AbyssVerbAudioProce
     setupKnob(delayMixKnob,  "delayMix",       "ECHO MIX",      mix);
     setupKnob(masterMixKnob, "masterMix",      "DRY / WET",     mix);
     setupKnob(bowSensKnob,   "bowSensitivity", "BOW FEEL",      juce::Colour(0xFFCC8855));
+
+    trueStereoButton.setColour(juce::ToggleButton::textColourId, deep.brighter(0.4f));
+    trueStereoButton.setColour(juce::ToggleButton::tickColourId, deep.brighter(0.4f));
+    trueStereoButton.setColour(juce::ToggleButton::tickDisabledColourId, deep.withAlpha(0.6f));
+    addAndMakeVisible(trueStereoButton);
+    trueStereoAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.apvts, "trueStereo", trueStereoButton);
+
+    // ID は InterpolationQuality + 1（ComboBox の ID 0 は「未選択」）
+    interpolationBox.addItem("LINEAR",   static_cast<int>(InterpolationQuality::linear) + 1);
+    interpolationBox.addItem("HERMITE",  static_cast<int>(InterpolationQuality::hermite) + 1);
+    interpolationBox.addItem("LAGRANGE", static_cast<int>(InterpolationQuality::lagrange) + 1);
+    interpolationBox.addItem("SINC",     static_cast<int>(InterpolationQuality::sinc) + 1);
+    interpolationBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A2030));
+    interpolationBox.setColour(juce::ComboBox::outlineColourId, fade.withAlpha(0.6f));
+    interpolationBox.setColour(juce::ComboBox::textColourId, fade.brighter(0.6f));
+    interpolationBox.setColour(juce::ComboBox::arrowColourId, fade.brighter(0.6f));
+    interpolationBox.setSelectedId(static_cast<int>(audioProcessor.getInterpolationQuality()) + 1,
+                                   juce::dontSendNotification);
+    interpolationBox.onChange = [this]
+    {
+        audioProcessor.setInterpolationQuality(
+            static_cast<InterpolationQuality>(interpolationBox.getSelectedId() - 1));
+    };
+    addAndMakeVisible(interpolationBox);
+
+    parallelButton.setColour(juce::ToggleButton::textColourId, mix.brighter(0.4f));
+    parallelButton.setColour(juce::ToggleButton::tickColourId, mix.brighter(0.4f));
+    parallelButton.setColour(juce::ToggleButton::tickDisabledColourId, mix.withAlpha(0.6f));
+    parallelButton.setToggleState(audioProcessor.isParallelChannels(), juce::dontSendNotification);
+    parallelButton.onClick = [this]
+    {
+        parallelButton.setToggleState(audioProcessor.setParallelChannels(parallelButton.getToggleState()),
+                                      juce::dontSendNotification);
+    };
+    addAndMakeVisible(parallelButton);
+
+    irButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF1A2030));
+    irButton.setColour(juce::TextButton::textColourOffId, deep.brighter(0.4f));
+    irButton.onClick = [this] { showImpulseResponseMenu(); };
+    addAndMakeVisible(irButton);
+    updateImpulseResponseButton();
+
+    addAndMakeVisible(visualizer);
+
+#if ABYSSVERB_PROFILING
+    addAndMakeVisible(dspLoadMeter); // 内訳を開くと下のセクションに重なるので最前面
+#endif
+}
+
+AbyssVerbAudioProcessorEditor::~AbyssVerbAudioProcessorEditor()
+{
+    setLookAndFeel(nullptr);
+}
+
+void AbyssVerbAudioProcessorEditor::showImpulseResponseMenu()
+{
+    juce::PopupMenu menu;
+    menu.addItem(1, "Load impulse response...");
+    menu.addItem(2, "Clear", audioProcessor.getEarlyReflectionsFile() != juce::File());
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&irButton),
+                       [safeThis = juce::Component::SafePointer<AbyssVerbAudioProcessorEditor>(this)](int result)
+                       {
+                           if (safeThis == nullptr)
+                               return;
+                           if (result == 1)
+                               safeThis->chooseImpulseResponse();
+                           else if (result == 2)
+                           {
+                               safeThis->audioProcessor.setEarlyReflectionsFile({});
+                               safeThis->updateImpulseResponseButton();
+                           }
+                       });
 }
 
-AbyssVerbAudioProcessorEditor::~AbyssVerbAudioProcessorEditor() {}
+void AbyssVerbAudioProcessorEditor::chooseImpulseResponse()
+{
+    irChooser = std::make_unique<juce::FileChooser>("Early reflections impulse response",
+                                                    audioProcessor.getEarlyReflectionsFile(),
+                                                    "*.wav;*.aif;*.aiff;*.flac");
+    irChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                           [this](const juce::FileChooser& chooser)
+                           {
+                               const auto file = chooser.getResult();
+                               if (file.existsAsFile())
+                               {
+                                   audioProcessor.setEarlyReflectionsFile(file);
+                                   updateImpulseResponseButton();
+                               }
+                           });
+}
+
+void AbyssVerbAudioProcessorEditor::updateImpulseResponseButton()
+{
+    const auto file = audioProcessor.getEarlyReflectionsFile();
+    irButton.setButtonText(file == juce::File() ? "EARLY IR: NONE" : "IR: " + file.getFileNameWithoutExtension());
+}
 
 void AbyssVerbAudioProcessorEditor::setupKnob(KnobWithLabel& knob,
                                                 const juce::String& paramId,
@@ -69,6 +236,24 @@ void AbyssVerbAudioProcessorEditor::setupKnob(KnobWithLabel& knob,
 
 void AbyssVerbAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    // ノブを回した時などはその周りだけがクリップ領域になるので、転送もその範囲で済む
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (! backgroundCache.isValid() || scale != backgroundScale)
+        renderBackground(scale);
+
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+}
+
+void AbyssVerbAudioProcessorEditor::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    backgroundCache = juce::Image(juce::Image::RGB,
+                                  juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                  juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                                  false);
+    juce::Graphics g(backgroundCache);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // 深い森の中の古い教会をイメージした背景
     juce::ColourGradient gradient(
         juce::Colour(0xFF0C0F15), 0.0f, 0.0f,
@@ -79,8 +264,8 @@ void AbyssVerbAudioProcessorEditor::paint(juce::Graphics& g)
     g.setGradientFill(gradient);
     g.fillAll();
 
-    // 微かな光の粒子
-    paintRandom.setSeed(54321);
+    // 微かな光の粒子（固定シードなので描き直しても同じ配置）
+    juce::Random paintRandom(54321);
     for (int i = 0; i < 60; ++i)
     {
         float x = paintRandom.nextFloat() * getWidth();
@@ -115,13 +300,20 @@ void AbyssVerbAudioProcessorEditor::paint(juce::Graphics& g)
     };
 
     drawSection(65.0f,  "// VIOLIN INPUT",     juce::Colour(0xFFB87A4B));
+    // 同じ段の右半分は帯域別減衰（ラベルだけ右に置く）
+    g.setColour(juce::Colour(0xFF3A7CA5).withAlpha(0.6f));
+    g.setFont(juce::Font(11.0f, juce::Font::bold));
+    g.drawText("// ABYSS TONE", getWidth() / 2 + 3, 67, 250, 16, juce::Justification::centredLeft);
     drawSection(195.0f, "// ABYSS REVERB",     juce::Colour(0xFF3A7CA5));
     drawSection(325.0f, "// VANISHING DELAY",  juce::Colour(0xFF6B5B73));
     drawSection(455.0f, "// MIX & EXPRESSION", juce::Colour(0xFF4A9EBF));
+    drawSection(590.0f, "// ABYSS MONITOR",    juce::Colour(0xFF8EBBCC));
 }
 
 void AbyssVerbAudioProcessorEditor::resized()
 {
+    backgroundCache = {};
+
     const int kw = 110;  // ノブ幅
     const int kh = 90;   // ノブ高さ
     const int lh = 15;   // ラベル高さ
@@ -132,10 +324,11 @@ void AbyssVerbAudioProcessorEditor::resized()
         knob.label.setBounds(x, y + kh, kw, lh);
     };
 
-    auto centerRow = [&](int numKnobs, int y, auto&&... knobs)
+    // [left, right) の中央に並べる
+    auto centerRowIn = [&](int left, int right, int numKnobs, int y, auto&&... knobs)
     {
         int totalW = numKnobs * kw + (numKnobs - 1) * 8;
-        int startX = (getWidth() - totalW) / 2;
+        int startX = left + (right - left - totalW) / 2;
         int idx = 0;
         auto place = [&](KnobWithLabel& k) {
             placeKnob(k, startX + idx * (kw + 8), y);
@@ -143,17 +336,247 @@ void AbyssVerbAudioProcessorEditor::resized()
         };
         (place(knobs), ...);
     };
+    auto centerRow = [&](int numKnobs, int y, auto&&... knobs)
+    {
+        centerRowIn(0, getWidth(), numKnobs, y, knobs...);
+    };
 
-    // バイオリン入力 (3ノブ)
-    centerRow(3, 80, piezoKnob, bodyKnob, brightnessKnob);
+    // バイオリン入力 (3ノブ、左半分) と帯域別減衰 (3ノブ、右半分)
+    centerRowIn(0, getWidth() / 2, 3, 80, piezoKnob, bodyKnob, brightnessKnob);
+    centerRowIn(getWidth() / 2, getWidth(), 3, 80, lowDepthKnob, highDepthKnob, depthSplitKnob);
 
-    // リバーブ (5ノブ)
-    centerRow(5, 210, decayKnob, dampHighKnob, dampLowKnob, shimmerKnob, swayKnob);
+    // リバーブ (6ノブ) + IR とモード切替（セクションラインの右端）
+    centerRow(6, 210, decayKnob, dampHighKnob, dampLowKnob, shimmerKnob, swayKnob, earlyKnob);
+    irButton.setBounds(getWidth() - 300, 197, 150, 16);
+    trueStereoButton.setBounds(getWidth() - 140, 197, 125, 16);
 
-    // ディレイ (6ノブ)
+    // ディレイ (6ノブ) + 補間品質（セクションラインの右端）
+    interpolationBox.setBounds(getWidth() - 95, 327, 80, 16); // 6ノブ行（x <= 800）に掛からない幅
     centerRow(6, 340, echoTimeKnob, echoSustainKnob, vanishKnob,
               fadeTexKnob, driftKnob, chorusKnob);
 
-    // ミックス (4ノブ)
+    // ミックス (4ノブ) + 並列処理（セクションラインの右端）
+    parallelButton.setBounds(getWidth() - 140, 457, 125, 16);
     centerRow(4, 470, reverbMixKnob, delayMixKnob, masterMixKnob, bowSensKnob);
+
+    // モニター
+    visualizer.setBounds(15, 610, getWidth() - 30, 100);
+
+#if ABYSSVERB_PROFILING
+    dspLoadMeter.setBounds(getWidth() - 215, 10, 200, dspLoadMeter.getPreferredHeight());
+#endif
+}
+
+//==============================================================================
+AbyssVisualizer::AbyssVisualizer(AbyssVerbAudioProcessor& processorToPoll)
+    : processor(processorToPoll)
+{
+    lineDb.fill(FLOOR_DB);
+    setOpaque(true);
+
+    // エディターを閉じていた間に溜まった古いフレームは表示しない
+    processor.discardVisualizerFrames();
+    startTimerHz(REFRESH_HZ);
+}
+
+void AbyssVisualizer::timerCallback()
+{
+    std::array<float, VisualizerFrame::NUM_LINES> energySum {};
+    int received = 0;
+
+    VisualizerFrame frame;
+    while (processor.popVisualizerFrame(frame))
+    {
+        float total = 0.0f;
+        for (size_t i = 0; i < energySum.size(); ++i)
+        {
+            energySum[i] += frame.lineEnergy[i];
+            total += frame.lineEnergy[i];
+        }
+        historyDb[static_cast<size_t>(historyWrite)] = toDecibels(total);
+        historyWrite = (historyWrite + 1) % HISTORY_SIZE;
+
+        latest = frame;
+        ++received;
+    }
+
+    // ホストが止まっている間（フレームが来ない間）は描き直さない
+    if (received == 0)
+        return;
+
+    for (size_t i = 0; i < lineDb.size(); ++i)
+        lineDb[i] = toDecibels(energySum[i] / static_cast<float>(received));
+    repaint();
+}
+
+void AbyssVisualizer::paint(juce::Graphics& g)
+{
+    const auto deep = juce::Colour(0xFF3A7CA5);
+    const auto fade = juce::Colour(0xFF6B5B73);
+    const auto warm = juce::Colour(0xFFCC8855);
+    const auto label = juce::Colour(0xFF6A8899);
+
+    g.fillAll(juce::Colour(0xFF0A0D14));
+    g.setFont(juce::Font(10.0f));
+
+    auto area = getLocalBounds().reduced(6);
+    const auto toY = [](juce::Rectangle<float> r, float db)
+    {
+        return juce::jmap(db, FLOOR_DB, 0.0f, r.getBottom(), r.getY());
+    };
+
+    // 減衰の軌跡（全ラインのエネルギー。最新が右端、横軸 HISTORY_SECONDS）
+    auto decay = area.removeFromLeft(area.getWidth() * 11 / 20).toFloat();
+    g.setColour(label.withAlpha(0.2f));
+    for (float db = -24.0f; db > FLOOR_DB; db -= 24.0f)
+        g.drawHorizontalLine(juce::roundToInt(toY(decay, db)), decay.getX(), decay.getRight());
+
+    juce::Path trace;
+    for (int i = 0; i < HISTORY_SIZE; ++i)
+    {
+        const float x = decay.getX() + decay.getWidth() * static_cast<float>(i) / static_cast<float>(HISTORY_SIZE - 1);
+        const float y = toY(decay, historyDb[static_cast<size_t>((historyWrite + i) % HISTORY_SIZE)]);
+        if (i == 0)
+            trace.startNewSubPath(x, y);
+        else
+            trace.lineTo(x, y);
+    }
+    g.setColour(deep.brighter(0.4f));
+    g.strokePath(trace, juce::PathStrokeType(1.2f));
+
+    g.setColour(label);
+    g.drawText(latest.sleeping ? "DECAY  (IDLE)" : "DECAY", decay.toNearestInt().removeFromTop(12),
+               juce::Justification::topLeft);
+    g.drawText(juce::String(static_cast<int>(FLOOR_DB)) + " dB", decay.toNearestInt().removeFromBottom(12),
+               juce::Justification::bottomRight);
+
+    area.removeFromLeft(12);
+
+    // 深淵リバーブの各ライン（dB）
+    auto lineArea = area.removeFromLeft(area.getWidth() / 2).toFloat();
+    g.setColour(label);
+    g.drawText("FDN LINES", lineArea.removeFromTop(12).toNearestInt(), juce::Justification::topLeft);
+    const float lineWidth = lineArea.getWidth() / static_cast<float>(VisualizerFrame::NUM_LINES);
+    for (int i = 0; i < VisualizerFrame::NUM_LINES; ++i)
+    {
+        const auto slot = lineArea.withX(lineArea.getX() + lineWidth * static_cast<float>(i)).withWidth(lineWidth).reduced(1.5f, 0.0f);
+        g.setColour(deep.withAlpha(0.15f));
+        g.fillRect(slot);
+        g.setColour(deep.brighter(0.2f));
+        g.fillRect(slot.withTop(toY(slot, lineDb[static_cast<size_t>(i)])));
+    }
+
+    area.removeFromLeft(12);
+
+    // 消失ディレイのタップ（L/R 各4本、0〜1）と右端に弓圧
+    auto tapArea = area.toFloat();
+    g.setColour(label);
+    g.drawText("TAPS L / R", tapArea.removeFromTop(12).toNearestInt(), juce::Justification::topLeft);
+    auto bowArea = tapArea.removeFromRight(14.0f);
+    const int numBars = VisualizerFrame::NUM_TAPS * 2;
+    const float tapWidth = (tapArea.getWidth() - 6.0f) / static_cast<float>(numBars);
+    for (int bar = 0; bar < numBars; ++bar)
+    {
+        const int ch = bar / VisualizerFrame::NUM_TAPS;
+        const float x = tapArea.getX() + tapWidth * static_cast<float>(bar) + (ch > 0 ? 6.0f : 0.0f);
+        const auto slot = tapArea.withX(x).withWidth(tapWidth).reduced(1.5f, 0.0f);
+        const float gain = juce::jlimit(0.0f, 1.0f, latest.tapGain[static_cast<size_t>(ch)]
+                                                                  [static_cast<size_t>(bar % VisualizerFrame::NUM_TAPS)]);
+        g.setColour(fade.withAlpha(0.2f));
+        g.fillRect(slot);
+        g.setColour(fade.brighter(0.5f));
+        g.fillRect(slot.withTop(slot.getBottom() - slot.getHeight() * gain));
+    }
+
+    for (size_t ch = 0; ch < latest.envelope.size(); ++ch)
+    {
+        const auto slot = bowArea.withWidth(bowArea.getWidth() / 2.0f)
+                                 .translated(bowArea.getWidth() / 2.0f * static_cast<float>(ch), 0.0f)
+                                 .reduced(1.0f, 0.0f);
+        const float level = juce::jlimit(0.0f, 1.0f, latest.envelope[ch]);
+        g.setColour(warm.withAlpha(0.2f));
+        g.fillRect(slot);
+        g.setColour(warm);
+        g.fillRect(slot.withTop(slot.getBottom() - slot.getHeight() * level));
+    }
+}
+
+#if ABYSSVERB_PROFILING
+//==============================================================================
+DspLoadMeter::DspLoadMeter(AbyssVerbAudioProcessor& processorToPoll)
+    : processor(processorToPoll)
+{
+    startTimerHz(10);
+}
+
+void DspLoadMeter::timerCallback()
+{
+    // 表示が変わる時だけ描き直す（0.1% 単位の数値と状態。内訳を開いている間は毎回）
+    const auto shown = [](const ProfileStatistics::Summary& s)
+    {
+        return std::make_tuple(juce::roundToInt(s.total.mean * 1000.0), juce::roundToInt(s.total.p99 * 1000.0),
+                               juce::roundToInt(s.total.max * 1000.0), s.overrun, s.nearDeadline, s.sleeping,
+                               s.windowBlocks == 0);
+    };
+
+    const auto previous = shown(summary);
+    summary = processor.pollDspLoad();
+    if (expanded || shown(summary) != previous)
+        repaint();
+}
+
+void DspLoadMeter::mouseUp(const juce::MouseEvent&)
+{
+    expanded = ! expanded;
+    setSize(getWidth(), getPreferredHeight());
+}
+
+void DspLoadMeter::paint(juce::Graphics& g)
+{
+    const auto normal = juce::Colour(0xFF6A8899);
+    const auto colour = summary.overrun ? juce::Colour(0xFFCC5544)
+                      : summary.nearDeadline ? juce::Colour(0xFFCC8855) : normal;
+    const auto percent = [](double load) { return juce::String(load * 100.0, 1) + "%"; };
+
+    g.setColour(juce::Colour(0xE00C0F15));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 3.0f);
+    g.setFont(juce::Font(10.0f));
+
+    // 1行目: 平均負荷のバー（縦線が p99）と数値
+    auto row = getLocalBounds().removeFromTop(COLLAPSED_HEIGHT).reduced(5, 4);
+    const auto bar = row.removeFromLeft(36).toFloat();
+    g.setColour(colour.withAlpha(0.25f));
+    g.fillRect(bar);
+    g.setColour(colour);
+    g.fillRect(bar.withWidth(bar.getWidth() * static_cast<float>(juce::jlimit(0.0, 1.0, summary.total.mean))));
+    g.fillRect(bar.getX() + bar.getWidth() * static_cast<float>(juce::jlimit(0.0, 1.0, summary.total.p99)) - 0.5f,
+               bar.getY(), 1.0f, bar.getHeight());
+
+    row.removeFromLeft(6);
+    const auto text = summary.windowBlocks == 0 ? juce::String("DSP --")
+                    : summary.sleeping          ? juce::String("DSP IDLE")
+                    : "DSP " + percent(summary.total.mean) + "  P99 " + percent(summary.total.p99)
+                        + "  MAX " + percent(summary.total.max);
+    g.drawText(text, row, juce::Justification::centredLeft);
+
+    if (! expanded)
+        return;
+
+    // 内訳: 段ごとの平均 / p99 負荷と、実時間を超えたブロック数
+    auto area = getLocalBounds().withTrimmedTop(COLLAPSED_HEIGHT).reduced(8, 0);
+    g.setColour(normal);
+    for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+    {
+        auto line = area.removeFromTop(ROW_HEIGHT);
+        const auto& stage = summary.stages[static_cast<size_t>(s)];
+        g.drawText(juce::String(profileStageName(static_cast<ProfileStage>(s))).toUpperCase(),
+                   line.removeFromLeft(90), juce::Justification::centredLeft);
+        g.drawText(percent(stage.mean) + " / " + percent(stage.p99), line, juce::Justification::centredRight);
+    }
+
+    auto line = area.removeFromTop(ROW_HEIGHT);
+    g.setColour(summary.overruns > 0 ? juce::Colour(0xFFCC5544) : normal);
+    g.drawText("OVERRUNS", line.removeFromLeft(90), juce::Justification::centredLeft);
+    g.drawText(juce::String(summary.overruns), line, juce::Justification::centredRight);
 }
+#endif
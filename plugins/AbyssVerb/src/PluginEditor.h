@@ -1,6 +1,104 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include <array>
+#include <tuple>
+#include <vector>
+
+//==============================================================================
+// ノブの描画 — LookAndFeel_V4 の回転ノブと同じ見た目で、値によらない軌道（背景の弧）の
+// 輪郭をノブの寸法ごとにキャッシュする（ストロークの輪郭計算が描画で一番重い）。
+// 全エディターで1つを共有する（juce::SharedResourcePointer、メッセージスレッドのみ）
+//==============================================================================
+class AbyssLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    void drawRotarySlider(juce::Graphics&, int x, int y, int width, int height, float sliderPos,
+                          float rotaryStartAngle, float rotaryEndAngle, juce::Slider&) override;
+
+private:
+    // 原点 (0, 0) に置いたノブの寸法（LookAndFeel_V4 と同じ割り付け）
+    struct RotaryGeometry
+    {
+        juce::Point<float> centre;
+        float arcRadius, lineWidth;
+    };
+    static RotaryGeometry getGeometry(int width, int height);
+
+    struct RotaryTrack
+    {
+        int width, height;
+        float startAngle, endAngle;
+        juce::Path outline; // ストローク済みの輪郭（fillPath で描く）
+    };
+    const juce::Path& getTrackOutline(int width, int height, float startAngle, float endAngle);
+
+    static constexpr size_t MAX_CACHED_TRACKS = 16;
+    std::vector<RotaryTrack> trackCache;
+};
+
+#if ABYSSVERB_PROFILING
+//==============================================================================
+// DSP 負荷メーター（ABYSSVERB_PROFILING ビルドのみ）— ブロック長の実時間に対する負荷の
+// 平均 / p99 / 最大を1行で表示し、クリックで段別の内訳を開閉する。
+// p99 が NEAR_DEADLINE_LOAD を超えると琥珀色、実時間を超えたブロックがあると赤
+//==============================================================================
+class DspLoadMeter : public juce::Component, private juce::Timer
+{
+public:
+    static constexpr int ROW_HEIGHT = 14;
+    static constexpr int COLLAPSED_HEIGHT = 18;
+    static constexpr int EXPANDED_HEIGHT = COLLAPSED_HEIGHT + ROW_HEIGHT * (NUM_PROFILE_STAGES + 1) + 4;
+
+    explicit DspLoadMeter(AbyssVerbAudioProcessor& processorToPoll);
+
+    int getPreferredHeight() const { return expanded ? EXPANDED_HEIGHT : COLLAPSED_HEIGHT; }
+
+    void paint(juce::Graphics&) override;
+    void mouseUp(const juce::MouseEvent&) override;
+
+private:
+    void timerCallback() override;
+
+    AbyssVerbAudioProcessor& processor;
+    ProfileStatistics::Summary summary;
+    bool expanded = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadMeter)
+};
+#endif
+
+//==============================================================================
+// 深淵モニター — エンジンの表示フィードを REFRESH_HZ で読み、全体のエネルギーの減衰の軌跡、
+// 深淵リバーブの各ラインのエネルギー、消失ディレイのタップゲイン（L/R）と弓圧を描く。
+// 溜まったフレームは毎回すべて読み、軌跡には全部を、バーには平均（エネルギー）か
+// 最新の値（ゲイン・弓圧）を使う。描画が遅れてもフレームが間引かれるだけで表示は止まらない
+//==============================================================================
+class AbyssVisualizer : public juce::Component, private juce::Timer
+{
+public:
+    static constexpr int REFRESH_HZ = 30;
+    static constexpr double HISTORY_SECONDS = 8.0;
+    static constexpr int HISTORY_SIZE = static_cast<int>(VisualizerFeed::FRAME_RATE * HISTORY_SECONDS);
+    static constexpr float FLOOR_DB = -96.0f;
+
+    explicit AbyssVisualizer(AbyssVerbAudioProcessor& processorToPoll);
+
+    void paint(juce::Graphics&) override;
+
+private:
+    void timerCallback() override;
+
+    static float toDecibels(float energy) { return juce::jmax(FLOOR_DB, 10.0f * std::log10(energy + 1.0e-20f)); }
+
+    AbyssVerbAudioProcessor& processor;
+    VisualizerFrame latest;
+    std::array<float, VisualizerFrame::NUM_LINES> lineDb;
+    std::vector<float> historyDb = std::vector<float>(static_cast<size_t>(HISTORY_SIZE), FLOOR_DB);
+    int historyWrite = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AbyssVisualizer)
+};
 
 class AbyssVerbAudioProcessorEditor : public juce::AudioProcessorEditor
 {
@@ -14,6 +112,9 @@ public:
 private:
     AbyssVerbAudioProcessor& audioProcessor;
 
+    // 子コンポーネントより先に構築し、後に破棄する
+    juce::SharedResourcePointer<AbyssLookAndFeel> lookAndFeel;
+
     struct KnobWithLabel
     {
         juce::Slider slider;
@@ -24,17 +125,48 @@ private:
     // バイオリン入力
     KnobWithLabel piezoKnob, bodyKnob, brightnessKnob;
     // リバーブ
-    KnobWithLabel decayKnob, dampHighKnob, dampLowKnob, shimmerKnob, swayKnob;
+    KnobWithLabel decayKnob, dampHighKnob, dampLowKnob, shimmerKnob, swayKnob, earlyKnob;
+    // リバーブの帯域別減衰
+    KnobWithLabel lowDepthKnob, highDepthKnob, depthSplitKnob;
     // ディレイ
     KnobWithLabel echoTimeKnob, echoSustainKnob, vanishKnob, fadeTexKnob, driftKnob, chorusKnob;
     // ミックス
     KnobWithLabel reverbMixKnob, delayMixKnob, masterMixKnob, bowSensKnob;
 
+    // リバーブモード（デュアルモノ / トゥルーステレオ）
+    juce::ToggleButton trueStereoButton { "TRUE STEREO" };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> trueStereoAttachment;
+
+    // 変調読み出しの補間品質（セッション設定なのでパラメーターではなくプロセッサーへ直接）
+    juce::ComboBox interpolationBox;
+
+    // L/R チェーンの並列処理（同じくセッション設定。有効にできなければチェックが外れる）
+    juce::ToggleButton parallelButton { "TWO CORES" };
+
+    // 初期反射の IR（クリックで読み込み / 解除のメニュー）
+    juce::TextButton irButton;
+    std::unique_ptr<juce::FileChooser> irChooser;
+    void showImpulseResponseMenu();
+    void chooseImpulseResponse();
+    void updateImpulseResponseButton();
+
+    // 深淵モニター（最下段）
+    AbyssVisualizer visualizer { audioProcessor };
+
+#if ABYSSVERB_PROFILING
+    // DSP 負荷メーター（タイトルの右）
+    DspLoadMeter dspLoadMeter { audioProcessor };
+#endif
+
     void setupKnob(KnobWithLabel& knob, const juce::String& paramId,
                    const juce::String& labelText,
                    juce::Colour fillColour = juce::Colour(0xFF4A9EBF));
 
-    juce::Random paintRandom;
+    // 静的な背景（グラデーション・光の粒子・タイトル・セクションライン）は画像に一度だけ描き、
+    // paint はそれを再描画の領域へ転送するだけにする。サイズか表示倍率が変わった時だけ描き直す
+    juce::Image backgroundCache;
+    float backgroundScale = 0.0f;
+    void renderBackground(float scale);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AbyssVerbAudioProcessorEditor)
 };
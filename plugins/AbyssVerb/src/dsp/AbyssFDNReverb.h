@@ -0,0 +1,673 @@
+#pragma once
+#include "DspCommon.h"
+#include "SimdFloat4.h"
+#include "DelayMemoryArena.h"
+#include "LfoBank.h"
+#include "FractionalDelay.h"
+#include "DspKernels.h"
+#include <cmath>
+#include <algorithm>
+
+//==============================================================================
+// 高速ウォルシュ・アダマール変換（インプレース、正規化なし）
+// 行列 H[i][j] = (-1)^popcount(i & j) の乗算を N log N の加減算で行う
+//==============================================================================
+template <int N>
+inline void fastWalshHadamard(float* data)
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Hadamard size must be a power of two");
+
+    for (int half = 1; half < N; half <<= 1)
+    {
+        for (int block = 0; block < N; block += half * 2)
+        {
+            for (int i = block; i < block + half; ++i)
+            {
+                const float a = data[i];
+                const float b = data[i + half];
+                data[i] = a + b;
+                data[i + half] = a - b;
+            }
+        }
+    }
+}
+
+//==============================================================================
+// 深淵リバーブ: N-line FDN — バイオリン最適化
+// 高域の減衰カーブをバイオリンの倍音構造に合わせて調整
+// ライン数はコンパイル時に固定（4/8/16/32）、既定は8ライン
+//==============================================================================
+template <int NumLines>
+class AbyssFDN
+{
+public:
+    static constexpr int NUM_LINES = NumLines;
+    static_assert(NUM_LINES >= 4 && NUM_LINES <= 32 && (NUM_LINES & (NUM_LINES - 1)) == 0,
+                  "AbyssFDN supports 4, 8, 16 or 32 lines");
+
+    // ゲインテーブルの更新間隔（この区間で線形補間する）
+    static constexpr int CONTROL_INTERVAL = 16;
+
+    // アリーナはこれまでに準備した最も高いレート（MAX_PREPARED_SAMPLE_RATE を指定していればそれ以上）の
+    // 長さで確保し、使うのは今のレートに要る長さだけ。容量に収まるレートへの切替は確保し直さず、
+    // ラインの中身と状態を残したまま新しいレートへ変換する
+    void prepare(double sampleRate, int /*samplesPerBlock*/)
+    {
+        const double previousRate = sr;
+        sr = sampleRate;
+        kernels = &SimdDispatch::select();
+
+        // 変調で最大 maxModSamples だけ長く読めるよう余裕を持たせてアリーナに確保
+        capacityRate = std::max({ capacityRate, sr, MAX_PREPARED_SAMPLE_RATE });
+        int minLengths[NUM_LINES];
+        for (int i = 0; i < NUM_LINES; ++i)
+            minLengths[i] = readSpan(baseLength(i, capacityRate), modulationSamples(capacityRate));
+        const bool allocated = arena.allocate(minLengths, NUM_LINES, lines);
+        FractionalDelay::Sinc::table(); // 係数表をオーディオスレッドより先に作る
+
+        maxModSamples = static_cast<float>(modulationSamples(sr));
+        longestRead = 0;
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            lineLength[i] = baseLength(i, sr);
+            longestRead = std::max(longestRead, readSpan(lineLength[i], maxModSamples));
+        }
+
+        if (allocated)
+        {
+            for (int i = 0; i < NUM_LINES; ++i)
+            {
+                writePos[i] = 0;
+                lines[i].setSize(writePos[i], DelayMemoryArena::nextPowerOfTwo(readSpan(lineLength[i], maxModSamples)));
+            }
+            clear();
+        }
+        else if (sr != previousRate)
+        {
+            // 残響の途中でレートが変わっても、読み出せる範囲の中身を新しい長さ・レートで並べ直して続ける
+            for (int i = 0; i < NUM_LINES; ++i)
+                lines[i].changeRate(writePos[i], longestRead, previousRate / sr,
+                                    DelayMemoryArena::nextPowerOfTwo(readSpan(lineLength[i], maxModSamples)));
+            quietSamples = std::min(static_cast<int>(quietSamples * sr / previousRate), longestRead);
+        }
+
+        updateFeedbackScale();
+
+        // ライン長が変わったのでゲインテーブルを即座に作り直す（ランプなし）
+        calcGainTable();
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            gainLo[i] = gainLoTarget[i];
+            gainHi[i] = gainHiTarget[i];
+        }
+        gainRampRemaining = 0;
+        gainsDirty = false;
+        controlCountdown = 0;
+    }
+
+    // glideSamples > 0 なら変調の深さはその長さをかけて線形に動かす（コントロールレートで
+    // 呼ばれても読み出し位置が段差なく動くように）。0 なら即座に切り替える
+    void setParameters(float decayTime, float dampHigh, float dampLow,
+                       float modDepth, float modRate, int glideSamples = 0)
+    {
+        // RT60ゲインは減衰時間が実際に変わった時のみ再計算
+        if (std::abs(decayTime - decay) > decay * DECAY_EPSILON)
+        {
+            decay = decayTime;
+            gainsDirty = true;
+        }
+        // ダンパーの最大ゲインによる正規化はコントロールレートで追従（ランプ中も CONTROL_INTERVAL ごとに1回）
+        if (dampHigh != dampingHigh || dampLow != dampingLow)
+        {
+            dampingHigh = dampHigh;
+            dampingLow = dampLow;
+            scaleDirty = true;
+        }
+        modGlideRemaining = modDepth != this->modDepth ? glideSamples : 0;
+        if (modGlideRemaining > 0)
+        {
+            modDepthTarget = modDepth;
+            modDepthStep = (modDepth - this->modDepth) / static_cast<float>(glideSamples);
+        }
+        else
+            this->modDepth = modDepth;
+        this->modRate = modRate;
+    }
+
+    // 周波数依存の減衰: 低域/高域のRT60を decay の倍率で指定（1.0, 1.0 で無効）
+    // シェルフ係数とゲインはパラメーター変更時にのみ、次のコントロール更新で計算される
+    void setDecayShelf(float lowDecayScale, float highDecayScale, float crossoverHz)
+    {
+        if (lowDecayScale == decayScaleLow && highDecayScale == decayScaleHigh
+            && crossoverHz == shelfCrossoverHz)
+            return;
+
+        decayScaleLow = lowDecayScale;
+        decayScaleHigh = highDecayScale;
+        shelfCrossoverHz = crossoverHz;
+        gainsDirty = true;
+    }
+
+    // 命令セット別カーネルの表を差し替える（prepare は SimdDispatch::select() の表を使う。ベンチマーク用）
+    void setKernels(const DspKernels& newKernels) { kernels = &newKernels; }
+
+    // 変調読み出しの補間カーネル（次のサンプルから反映）
+    void setInterpolation(InterpolationQuality newQuality) { interpolation = newQuality; }
+
+    // envelopeで弓圧に応じてリバーブの広がり方を変える
+    float process(float input, float envelope = 0.0f)
+    {
+        alignas(16) float lfo[NUM_LINES];
+        renderModulation(lfo, 1);
+        float output = 0.0f;
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            output = processMono<decltype(kernel)>(input, envelope, lfo);
+        });
+        return output;
+    }
+
+    // スカラー参照実装版の process。SIMD版の出力検証用
+    // （FMA縮約なしのビルドではビット単位で一致する）
+    float processReference(float input, float envelope = 0.0f)
+    {
+        alignas(16) float injection[NUM_LINES];
+        alignas(16) float outputs[NUM_LINES];
+        alignas(16) float lfo[NUM_LINES];
+        renderModulation(lfo, 1);
+        std::fill(injection, injection + NUM_LINES, input / static_cast<float>(NUM_LINES));
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            tickReference<decltype(kernel)>(injection, envelope, lfo, outputs);
+        });
+        return mixOutputs(outputs, 0, 1);
+    }
+
+    // トゥルーステレオ: L を偶数ライン、R を奇数ラインに注入し、同じ振り分けで取り出す。
+    // Hadamard行列が両側を拡散するので、1つのネットワークで左右の残響が得られる
+    void processStereo(float inputL, float inputR, float envelope, float& outL, float& outR)
+    {
+        alignas(16) float lfo[NUM_LINES];
+        renderModulation(lfo, 1);
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            processStereoFrame<decltype(kernel)>(inputL, inputR, envelope, lfo, outL, outR);
+        });
+    }
+
+    // モノ入力 → ステレオ出力: 全ラインに注入し、偶数/奇数ラインから左右を取り出す
+    void processMonoToStereo(float input, float envelope, float& outL, float& outR)
+    {
+        alignas(16) float lfo[NUM_LINES];
+        renderModulation(lfo, 1);
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            processMonoToStereoFrame<decltype(kernel)>(input, envelope, lfo, outL, outR);
+        });
+    }
+
+    // ブロック処理。フィードバックループなのでサンプル単位で回すが、
+    // LFOはまとめて生成し、補間カーネルの選択もブロックで1回だけ行う。
+    // 呼び出し側は段ごとにブロックを通せる（in == out 可）
+    void process(const float* input, const float* envelope, float* output, int numSamples)
+    {
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            using Kernel = decltype(kernel);
+            processModulated(numSamples, [&](int i, const float* lfo)
+            {
+                output[i] = processMono<Kernel>(input[i], envelope[i], lfo);
+            });
+        });
+    }
+
+    void processStereo(const float* inputL, const float* inputR, const float* envelope,
+                       float* outL, float* outR, int numSamples)
+    {
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            using Kernel = decltype(kernel);
+            processModulated(numSamples, [&](int i, const float* lfo)
+            {
+                processStereoFrame<Kernel>(inputL[i], inputR[i], envelope[i], lfo, outL[i], outR[i]);
+            });
+        });
+    }
+
+    void processMonoToStereo(const float* input, const float* envelope,
+                             float* outL, float* outR, int numSamples)
+    {
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            using Kernel = decltype(kernel);
+            processModulated(numSamples, [&](int i, const float* lfo)
+            {
+                processMonoToStereoFrame<Kernel>(input[i], envelope[i], lfo, outL[i], outR[i]);
+            });
+        });
+    }
+
+    void clear()
+    {
+        DelayMemoryArena::clear(lines, NUM_LINES);
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            dampState[i] = dampLo[i] = dampHi[i] = 0.0f;
+            shelfState[i] = 0.0f;
+        }
+        resetModulation();
+        quietSamples = longestRead;
+    }
+
+    // ラインに SILENCE_LEVEL を超える値が残っていないか。最後に大きな値を書いてから
+    // 最長の読み出し遅延ぶん書き進めていれば、もう出力に現れない
+    bool isSilent() const { return quietSamples >= longestRead; }
+
+    // 各ラインに直近 ENERGY_WINDOW サンプルで書いた値の平均二乗（表示用。読むだけで状態は変えない）
+    static constexpr int ENERGY_WINDOW = 16;
+    void getLineEnergies(float* energies) const
+    {
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            float sum = 0.0f;
+            for (int k = 1; k <= ENERGY_WINDOW; ++k)
+            {
+                const float x = *lines[i].tap(writePos[i] - k);
+                sum += x * x;
+            }
+            energies[i] = sum / static_cast<float>(ENERGY_WINDOW);
+        }
+    }
+
+private:
+    static constexpr float DECAY_EPSILON = 1.0e-4f;
+    // 変調の最大振れ幅 (modDepth 3ms × 弓圧による最大3倍 + 余裕)
+    static constexpr float MAX_MOD_MS = 10.0f;
+    // ブロック処理でLFOをまとめて生成する単位
+    static constexpr int MOD_CHUNK = LfoBank<NUM_LINES>::CONTROL_INTERVAL;
+
+    // バイオリン用: やや長めのディレイ長で豊かな残響密度
+    // 素数ベース、大きな空間をシミュレート（先頭からNUM_LINES本を使用）
+    static int baseLength(int line, double sampleRate)
+    {
+        static constexpr int baseLengths[32] = {
+            1801, 1913, 1657, 1543, 1381, 1471, 1259, 1163,
+            2003, 1123, 1721, 1597, 1451, 1327, 1223, 1097,
+            2089, 2141, 1871, 1777, 1613, 1487, 1409, 1303,
+            1201, 1069, 1033, 1987, 1747, 1559, 1367, 1289
+        };
+        return static_cast<int>(baseLengths[line] * sampleRate / 44100.0);
+    }
+
+    static double modulationSamples(double sampleRate) { return MAX_MOD_MS * sampleRate / 1000.0; }
+
+    // ライン長 length を変調込みで読むのに要る長さ
+    static int readSpan(int length, double modulation)
+    {
+        return length + static_cast<int>(std::ceil(modulation)) + FractionalDelay::MAX_TAPS;
+    }
+
+    // LFOを初期位相に戻す（clear 後の出力を毎回同じにするため）
+    void resetModulation()
+    {
+        float lfoPhases[NUM_LINES];
+        for (int i = 0; i < NUM_LINES; ++i)
+            lfoPhases[i] = static_cast<float>(i) / NUM_LINES;
+        lfoBank.reset(lfoPhases);
+    }
+
+    // numSamples 分の変調波形（sin + 三角波のブレンド、[サンプル][ライン]）を lfo に書き出す
+    void renderModulation(float* lfo, int numSamples)
+    {
+        using V = SimdFloat4;
+        alignas(16) float phases[MOD_CHUNK * NUM_LINES];
+
+        lfoBank.setIncrement(modRate / static_cast<float>(sr));
+        lfoBank.render(lfo, phases, numSamples);
+
+        // 各ラインで異なる位相のLFO波形（sin + 三角波のブレンド）
+        const V half = V::broadcast(0.5f), four = V::broadcast(4.0f), one = V::broadcast(1.0f);
+        const V sinMix = V::broadcast(0.7f), triMix = V::broadcast(0.3f);
+        for (int i = 0; i < numSamples * NUM_LINES; i += V::SIZE)
+        {
+            const V tri = four * V::abs(V::load(phases + i) - half) - one;
+            (V::load(lfo + i) * sinMix + tri * triMix).store(lfo + i);
+        }
+    }
+
+    // LFOを MOD_CHUNK 単位で生成しながら sampleFn(サンプル番号, そのサンプルのLFO値) を回す
+    template <typename SampleFn>
+    void processModulated(int numSamples, SampleFn&& sampleFn)
+    {
+        alignas(16) float lfo[MOD_CHUNK * NUM_LINES];
+        for (int start = 0; start < numSamples; start += MOD_CHUNK)
+        {
+            const int len = std::min(MOD_CHUNK, numSamples - start);
+            renderModulation(lfo, len);
+            for (int i = 0; i < len; ++i)
+                sampleFn(start + i, lfo + i * NUM_LINES);
+        }
+    }
+
+    template <typename Kernel>
+    float processMono(float input, float envelope, const float* lfo)
+    {
+        alignas(16) float injection[NUM_LINES];
+        alignas(16) float outputs[NUM_LINES];
+        std::fill(injection, injection + NUM_LINES, input / static_cast<float>(NUM_LINES));
+        tickSimd<Kernel>(injection, envelope, lfo, outputs);
+        return mixOutputs(outputs, 0, 1);
+    }
+
+    template <typename Kernel>
+    void processStereoFrame(float inputL, float inputR, float envelope, const float* lfo,
+                            float& outL, float& outR)
+    {
+        alignas(16) float injection[NUM_LINES];
+        alignas(16) float outputs[NUM_LINES];
+        // 片側 N/2 本に注入するので、デュアルモノと同じエネルギーになるよう √2/N
+        const float gain = 1.41421356f / static_cast<float>(NUM_LINES);
+        for (int i = 0; i < NUM_LINES; i += 2)
+        {
+            injection[i] = inputL * gain;
+            injection[i + 1] = inputR * gain;
+        }
+        tickSimd<Kernel>(injection, envelope, lfo, outputs);
+        outL = mixOutputs(outputs, 0, 2);
+        outR = mixOutputs(outputs, 1, 2);
+    }
+
+    template <typename Kernel>
+    void processMonoToStereoFrame(float input, float envelope, const float* lfo,
+                                  float& outL, float& outR)
+    {
+        alignas(16) float injection[NUM_LINES];
+        alignas(16) float outputs[NUM_LINES];
+        std::fill(injection, injection + NUM_LINES, input / static_cast<float>(NUM_LINES));
+        tickSimd<Kernel>(injection, envelope, lfo, outputs);
+        outL = mixOutputs(outputs, 0, 2);
+        outR = mixOutputs(outputs, 1, 2);
+    }
+
+    // 読み出し位置 = writePos - len + modSamples。整数部はビットマスクで折り返し、
+    // カーネルの TAPS 点 (idx - FIRST ..) はガード領域により連続で読める
+    template <typename Kernel>
+    const float* readTaps(int i, float modSamples, float& frac) const
+    {
+        const float mod = std::min(std::max(modSamples, -maxModSamples), maxModSamples);
+        int whole = static_cast<int>(mod);
+        if (mod < static_cast<float>(whole)) --whole;
+        frac = mod - static_cast<float>(whole);
+        return lines[i].tap(writePos[i] - lineLength[i] + whole - Kernel::FIRST);
+    }
+
+    // スカラー参照実装: 1ラインずつ処理する
+    template <typename Kernel>
+    void tickReference(const float* injection, float envelope, const float* lfo, float* outputs)
+    {
+        beginSample();
+
+        // エンベロープによる動的変調: 強く弾くとモジュレーションが深くなる
+        float dynamicMod = modDepth * (1.0f + envelope * 2.0f);
+
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            float modSamples = lfo[i] * dynamicMod * (static_cast<float>(sr) / 1000.0f);
+
+            // 補間読み出し（バイオリンの高域倍音を保つため、既定は3次以上）
+            float frac;
+            const float* taps = readTaps<Kernel>(i, modSamples, frac);
+            outputs[i] = FractionalDelay::read<Kernel>(taps, frac);
+        }
+
+        // Hadamardフィードバック（バタフライ演算）
+        float feedback[NUM_LINES];
+        std::copy(outputs, outputs + NUM_LINES, feedback);
+        fastWalshHadamard<NUM_LINES>(feedback);
+        for (int i = 0; i < NUM_LINES; ++i)
+            feedback[i] *= feedbackScale;
+
+        float peak = 0.0f;
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            float decayed;
+            if (shelfActive)
+            {
+                // ラインごとのシェルフ: 低域と高域に別々のRT60ゲインを掛ける
+                shelfState[i] += shelfCoeff * (feedback[i] - shelfState[i]);
+                decayed = shelfState[i] * gainLo[i] + (feedback[i] - shelfState[i]) * gainHi[i];
+            }
+            else
+            {
+                decayed = feedback[i] * gainLo[i];
+            }
+
+            float sig = decayed + injection[i];
+
+            // 2バンド周波数依存ダンピング
+            // 高域（バイオリンの倍音がゆっくり消えていく）
+            dampHi[i] = sig * (1.0f - dampingHigh) + dampHi[i] * dampingHigh;
+            // 低域（深い残響の膨らみを制御）
+            float hiPassed = sig - dampHi[i];
+            dampLo[i] = hiPassed * (1.0f - dampingLow) + dampLo[i] * dampingLow;
+            float processed = dampHi[i] + dampLo[i];
+
+            lines[i].write(writePos[i], processed);
+            writePos[i] = (writePos[i] + 1) & lines[i].mask;
+            peak = std::max(peak, std::abs(processed));
+        }
+        trackSilence(peak);
+    }
+
+    // SIMD版: 変調量と読み出し位置をここで求め、補間・Hadamardフィードバック・ゲイン・
+    // 2バンドダンパーは命令セット別のカーネルでレーン単位に処理する。
+    // ディレイへの書き込みのみをラインごとに行う（injection / lfo / outputs は16バイト境界）
+    template <typename Kernel>
+    void tickSimd(const float* injection, float envelope, const float* lfo, float* outputs)
+    {
+        using V = SimdFloat4;
+        constexpr int W = V::SIZE;
+
+        beginSample();
+
+        const float fs = static_cast<float>(sr);
+        float dynamicMod = modDepth * (1.0f + envelope * 2.0f);
+
+        // LFO → 変調量（サンプル）
+        alignas(16) float modSamples[NUM_LINES];
+        const V modScale = V::broadcast(dynamicMod), msToSamples = V::broadcast(fs / 1000.0f);
+        for (int i = 0; i < NUM_LINES; i += W)
+            (V::load(lfo + i) * modScale * msToSamples).store(modSamples + i);
+
+        // 読み出し位置
+        const float* taps[NUM_LINES];
+        alignas(16) float frac[NUM_LINES];
+        for (int i = 0; i < NUM_LINES; ++i)
+            taps[i] = readTaps<Kernel>(i, modSamples[i], frac[i]);
+
+        DspKernels::FdnLines state;
+        state.numLines = NUM_LINES;
+        state.gainLo = gainLo;
+        state.gainHi = gainHi;
+        state.shelfState = shelfState;
+        state.dampHi = dampHi;
+        state.dampLo = dampLo;
+        state.feedbackScale = feedbackScale;
+        state.shelfActive = shelfActive;
+        state.shelfCoeff = shelfCoeff;
+        state.dampingHigh = dampingHigh;
+        state.dampingLow = dampingLow;
+        state.sincCoefficients = FractionalDelay::Sinc::table().coefficients;
+
+        alignas(16) float processed[NUM_LINES];
+        kernels->fdnTick[static_cast<int>(Kernel::QUALITY)](state, taps, frac, injection, outputs, processed);
+
+        float peak = 0.0f;
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            lines[i].write(writePos[i], processed[i]);
+            writePos[i] = (writePos[i] + 1) & lines[i].mask;
+            peak = std::max(peak, std::abs(processed[i]));
+        }
+        trackSilence(peak);
+    }
+
+    // このサンプルで書いた値の最大振幅から、無音の書き込みが続いた長さを数える
+    void trackSilence(float peak)
+    {
+        quietSamples = peak > SILENCE_LEVEL ? 0 : std::min(quietSamples + 1, longestRead);
+    }
+
+    // first から stride おきのライン出力の和。1/√(本数) で正規化
+    static float mixOutputs(const float* outputs, int first, int stride)
+    {
+        float sum = 0.0f;
+        for (int i = first; i < NUM_LINES; i += stride)
+            sum += outputs[i];
+        return sum * (1.0f / std::sqrt(static_cast<float>(NUM_LINES / stride)));
+    }
+
+    // Hadamard の正規化 1/√N を2バンドダンパーの最大ゲインで割る。
+    // ダンパー H = LP高(x) + LP低(x - LP高(x)) は、2つの高域通過の位相の進みが重なる低中域で
+    // 1 を超える（既定値で +4%、最大 +15%）。そのままだと長い残響でループゲインが 1 を超えて
+    // 発振するので、最も減衰の遅い帯域の RT60 が decay に一致するようフィードバックを下げる
+    void updateFeedbackScale()
+    {
+        scaleDirty = false;
+        feedbackScale = static_cast<float>(1.0 / (std::sqrt(static_cast<double>(NUM_LINES))
+                                                  * dampingPeakGain(dampingHigh, dampingLow)));
+    }
+
+    // 1次ローパス2段（係数 a, b）のダンパーの振幅の最大値。
+    // H(z) = ((1-ab) - (a+b-2ab) z^-1) / ((1 - a z^-1)(1 - b z^-1)) なので |H|² は x = cos ω の
+    // 有理式 (P - Qx) / ((A - Bx)(C - Dx)) になり、極値は 2次方程式 QF x² - 2PF x + (PE - QG) = 0 の根
+    static double dampingPeakGain(double a, double b)
+    {
+        const double c = a + b - 2.0 * a * b;
+        const double P = (1.0 - a * b) * (1.0 - a * b) + c * c, Q = 2.0 * (1.0 - a * b) * c;
+        const double A = 1.0 + a * a, B = 2.0 * a, C = 1.0 + b * b, D = 2.0 * b;
+        const double E = A * D + B * C, F = B * D, G = A * C;
+        const auto gainSquared = [&](double x) { return (P - Q * x) / ((A - B * x) * (C - D * x)); };
+
+        double peak = std::max(gainSquared(-1.0), gainSquared(1.0)); // ナイキスト / 直流（= 1）
+        const double qa = Q * F, qb = -2.0 * P * F, qc = P * E - Q * G;
+        const double discriminant = qb * qb - 4.0 * qa * qc;
+        if (qa != 0.0 && discriminant >= 0.0)
+        {
+            for (double sign : { -1.0, 1.0 })
+            {
+                const double x = (-qb + sign * std::sqrt(discriminant)) / (2.0 * qa);
+                if (x > -1.0 && x < 1.0)
+                    peak = std::max(peak, gainSquared(x));
+            }
+        }
+        return std::sqrt(peak);
+    }
+
+    // サンプル先頭の共通処理: コントロール更新とRT60ゲインのランプ
+    void beginSample()
+    {
+        if (controlCountdown <= 0)
+            updateControl();
+        --controlCountdown;
+
+        if (modGlideRemaining > 0)
+            modDepth = --modGlideRemaining > 0 ? modDepth + modDepthStep : modDepthTarget;
+
+        // RT60ゲイン（テーブル値、更新直後は区間内で線形補間）
+        if (gainRampRemaining > 0)
+        {
+            const bool last = --gainRampRemaining == 0;
+            for (int i = 0; i < NUM_LINES; ++i)
+            {
+                gainLo[i] = last ? gainLoTarget[i] : gainLo[i] + gainLoStep[i];
+                gainHi[i] = last ? gainHiTarget[i] : gainHi[i] + gainHiStep[i];
+            }
+        }
+    }
+
+    void updateControl()
+    {
+        controlCountdown = CONTROL_INTERVAL;
+        if (scaleDirty)
+            updateFeedbackScale();
+        if (! gainsDirty)
+            return;
+
+        calcGainTable();
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            gainLoStep[i] = (gainLoTarget[i] - gainLo[i]) / static_cast<float>(CONTROL_INTERVAL);
+            gainHiStep[i] = (gainHiTarget[i] - gainHi[i]) / static_cast<float>(CONTROL_INTERVAL);
+        }
+        gainRampRemaining = CONTROL_INTERVAL;
+        gainsDirty = false;
+    }
+
+    // g = 10^(-3 * len / (RT60 * sr)) をライン・帯域ごとに計算
+    void calcGainTable()
+    {
+        const float fs = static_cast<float>(sr);
+        const bool wasActive = shelfActive;
+        shelfActive = decayScaleLow != 1.0f || decayScaleHigh != 1.0f;
+        // 止まっていた間のシェルフ状態は古い（止まっている間は低域/高域のゲインが等しく、状態を使わない）
+        if (shelfActive && ! wasActive)
+            for (int i = 0; i < NUM_LINES; ++i)
+                shelfState[i] = 0.0f;
+
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            const float len = static_cast<float>(lineLength[i]);
+            gainLoTarget[i] = std::pow(10.0f, -3.0f * len / (decay * decayScaleLow * fs));
+            gainHiTarget[i] = shelfActive
+                ? std::pow(10.0f, -3.0f * len / (decay * decayScaleHigh * fs))
+                : gainLoTarget[i];
+        }
+
+        shelfCoeff = 1.0f - std::exp(-2.0f * DspConstants<float>::pi * shelfCrossoverHz / fs);
+    }
+
+    double sr = 48000.0;
+    double capacityRate = 0.0; // アリーナを確保したレート（これまでの最大）
+    DelayMemoryArena arena;
+    DelayMemoryArena::Line lines[NUM_LINES];
+    int lineLength[NUM_LINES] = {};
+    int writePos[NUM_LINES] = {};
+    float maxModSamples = 0.0f;
+    int longestRead = 0;        // 変調込みで最も遠い読み出し（= 最長の minLengths）
+    int quietSamples = 0;       // SILENCE_LEVEL 以下の書き込みが続いたサンプル数（longestRead で頭打ち）
+    float dampState[NUM_LINES] = {};
+    // SIMD版がレーン単位で読み書きする状態は16バイト境界に揃える
+    alignas(16) float dampLo[NUM_LINES] = {};
+    alignas(16) float dampHi[NUM_LINES] = {};
+    LfoBank<NUM_LINES> lfoBank;
+    InterpolationQuality interpolation = InterpolationQuality::hermite;
+    const DspKernels* kernels = &SimdDispatch::baseline();
+
+    // RT60ゲインテーブル（低域/高域）
+    alignas(16) float gainLo[NUM_LINES] = {};
+    alignas(16) float gainHi[NUM_LINES] = {};
+    float gainLoTarget[NUM_LINES] = {}, gainHiTarget[NUM_LINES] = {};
+    float gainLoStep[NUM_LINES] = {}, gainHiStep[NUM_LINES] = {};
+    alignas(16) float shelfState[NUM_LINES] = {};
+    int gainRampRemaining = 0;
+    int controlCountdown = 0;
+    bool gainsDirty = false;
+
+    bool shelfActive = false;
+    float shelfCoeff = 0.0f;
+    float decayScaleLow = 1.0f, decayScaleHigh = 1.0f;
+    float shelfCrossoverHz = 1500.0f;
+
+    float decay = 6.0f;
+    float dampingHigh = 0.7f;
+    float dampingLow = 0.3f;
+    float feedbackScale = 0.0f; // 1/√N ÷ ダンパーの最大ゲイン（updateFeedbackScale）
+    bool scaleDirty = false;    // ダンパー係数が変わった（次のコントロール更新で feedbackScale を再計算）
+    float modDepth = 0.5f;
+    float modDepthTarget = 0.5f, modDepthStep = 0.0f; // 変調の深さの線形の移動（setParameters）
+    int modGlideRemaining = 0;
+    float modRate = 0.2f;
+};
+
+using AbyssFDNReverb = AbyssFDN<8>;
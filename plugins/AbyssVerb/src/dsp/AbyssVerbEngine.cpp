@@ -0,0 +1,618 @@
+#include "AbyssVerbEngine.h"
+#include <chrono>
+#include <limits>
+
+AbyssVerbEngine::AbyssVerbEngine()
+{
+    using P = Param;
+    using Shape = SmoothedParameters::RampShape;
+
+    // 既定は 10ms の指数ランプ。ここで決めた時間は prepare（reset）をまたいで保たれる
+    // ゲインは決まった時間で終わる線形ランプ（クロスフェードの長さが値の差によらない）
+    for (auto param : { P::reverbMix, P::delayMix, P::masterMix, P::earlyLevel })
+        smoothed.setRampTime(param, 0.02f, Shape::linear);
+    // ディレイ時間は読み出し位置が速く動くとピッチが跳ぶので、ゆっくり追従させる
+    smoothed.setRampTime(P::delayTime, 0.1f, Shape::exponential);
+    // 吸着の段差は読み出し位置の跳びになるので、192kHz でも 1/50 サンプル未満にする
+    smoothed.setSettleThreshold(P::delayTime, 1.0e-4f);
+    // 減衰・ダンピングは係数の更新間隔（コントロールレート）より十分長くかけて段差を目立たせない
+    for (auto param : { P::reverbDecay, P::reverbDampHigh, P::reverbDampLow,
+                        P::reverbLowDecay, P::reverbHighDecay, P::reverbCrossover })
+        smoothed.setRampTime(param, 0.05f, Shape::exponential);
+}
+
+void AbyssVerbEngine::prepare(double sampleRate, int maxBlockSize, const ParamSnapshot& initialParams)
+{
+    const bool reprepare = prepared;
+    const bool rateChanged = ! prepared || sampleRate != sr;
+    sr = sampleRate;
+    kernels = &SimdDispatch::select();
+
+    // ディレイ・残響のラインはこれまでに確保した長さに収まれば、中身を新しいレートへ移すだけ
+    for (size_t ch = 0; ch < channels.size(); ++ch)
+    {
+        auto& c = channels[ch];
+        c.reverb.prepare(sampleRate, maxBlockSize);
+        c.delay.prepare(sampleRate, maxBlockSize);
+        if (! reprepare)
+            c.delay.setSeed(seeds[ch].load(std::memory_order_relaxed));
+    }
+    if (! reprepare)
+        seedsChanged.store(false, std::memory_order_relaxed);
+    reverbStereo.prepare(sampleRate, maxBlockSize);
+
+    // スムーザー初期化 — 現在のパラメーター値でランプなしに確定。ランプバッファは MAX_BLOCK_SIZE で
+    // 確保しておき、ブロック長（処理の区切り）だけを切り替える
+    smoothed.reserve(MAX_BLOCK_SIZE);
+    smoothed.reset(sampleRate, std::min(maxBlockSize, MAX_BLOCK_SIZE));
+    smoothed.setCurrentValues(initialParams);
+
+    // ブロック内の中間信号（初回だけ MAX_BLOCK_SIZE で確保）
+    if (! reprepare)
+    {
+        const auto blockCapacity = static_cast<size_t>(MAX_BLOCK_SIZE);
+        for (auto& c : channels)
+            for (auto* buffer : { &c.dry, &c.bowEnv, &c.delayOut, &c.earlyOut, &c.reverbIn, &c.reverbOut })
+                buffer->assign(blockCapacity, 0.0f);
+        for (auto* buffer : { &blendBuffer, &stereoIn, &stereoEnv, &stereoOutL, &stereoOutR })
+            buffer->assign(blockCapacity, 0.0f);
+    }
+
+    // 設定済みの IR はこのサンプルレートで作り直す（レートが同じなら何もしない）
+    earlyReflections.prepare(sampleRate, MAX_BLOCK_SIZE);
+
+    trueStereoBlendStep = 1.0f / (static_cast<float>(sampleRate) * 0.05f);
+    silenceHoldSamples = static_cast<int>(std::ceil(sampleRate * SILENCE_HOLD_SECONDS));
+    visualizer.prepare(sampleRate);
+
+    // リアルタイムのワーカーには新しいブロック周期を申告し直す
+    workerPeriodSeconds = std::min(maxBlockSize, MAX_BLOCK_SIZE) / sampleRate;
+    if (chainWorker.getPriority() == WorkerPriority::realtime)
+        chainWorker.setPriority(WorkerPriority::realtime, workerPeriodSeconds);
+    parallelBackoffSamples = static_cast<int>(std::ceil(sampleRate * PARALLEL_BACKOFF_SECONDS));
+    parallelBackoff = 0;
+
+#if ABYSSVERB_PROFILING
+    profiler.prepare(sampleRate);
+#endif
+
+    prepared = true;
+    if (! reprepare)
+    {
+        trueStereoBlend = initialParams.isOn(Param::trueStereo) ? 1.0f : 0.0f;
+        reset();
+    }
+    else if (rateChanged)
+    {
+        // 係数がレートで決まる短い段（コンディショナー・エンベロープ）だけ作り直す。
+        // ディレイ・残響のテールとトゥルーステレオの切替状態はそのまま続ける
+        prepareShortStages();
+    }
+}
+
+void AbyssVerbEngine::prepareShortStages()
+{
+    for (auto& c : channels)
+    {
+        // コンディショナーとエンベロープは prepare が状態リセットを兼ねる（確保なし）
+        c.conditioner.prepare(sr);
+        c.envFollower.prepare(sr);
+        c.envFollower.setParameters(5.0f, 150.0f);  // 弓の速いアタック、ゆっくりリリース
+    }
+}
+
+void AbyssVerbEngine::reset()
+{
+    prepareShortStages();
+    for (auto& c : channels)
+    {
+        c.reverb.clear();
+        c.delay.clear();
+        c.dcBlocker.reset();
+    }
+    reverbStereo.clear();
+    earlyReflections.clear();
+
+    quietSamples = 0;
+    sleeping.store(false, std::memory_order_relaxed);
+}
+
+void AbyssVerbEngine::setRandomSeeds(std::uint32_t left, std::uint32_t right)
+{
+    seeds[LEFT].store(left, std::memory_order_relaxed);
+    seeds[RIGHT].store(right, std::memory_order_relaxed);
+    seedsChanged.store(true, std::memory_order_release);
+}
+
+bool AbyssVerbEngine::setParallelChannels(bool shouldRunInParallel, WorkerPriority priority)
+{
+    bool enabled = shouldRunInParallel;
+    if (shouldRunInParallel)
+    {
+        chainWorker.start();
+        if (chainWorker.getPriority() != priority)
+            enabled = chainWorker.setPriority(priority, workerPeriodSeconds);
+    }
+
+    parallelChannels.store(enabled, std::memory_order_relaxed);
+    return enabled;
+}
+
+void AbyssVerbEngine::process(const float* inL, const float* inR, float* outL, float* outR,
+                              int numSamples, const ParamSnapshot& params)
+{
+    ScopedFlushDenormals noDenormals;
+#if ABYSSVERB_PROFILING
+    profiler.beginBlock();
+#endif
+
+    if (seedsChanged.exchange(false, std::memory_order_acquire))
+        for (size_t ch = 0; ch < channels.size(); ++ch)
+            channels[ch].delay.setSeed(seeds[ch].load(std::memory_order_relaxed));
+
+    const auto quality = interpolation.load(std::memory_order_relaxed);
+    for (auto& c : channels)
+    {
+        c.delay.setInterpolation(quality);
+        c.reverb.setInterpolation(quality);
+    }
+    reverbStereo.setInterpolation(quality);
+
+    // トゥルーステレオ切替: 活性化する側のネットワークは古い残響を消してからクロスフェード
+    const float trueStereoTarget = params.isOn(Param::trueStereo) ? 1.0f : 0.0f;
+    clearActivatingNetwork(trueStereoTarget);
+
+    // モノ入力対応: 入力はLのみ、出力は常にステレオ
+    blockMono = inR == nullptr;
+    const bool parallel = parallelChannels.load(std::memory_order_relaxed) && chainWorker.isRunning();
+
+    auto& left = channels[LEFT];
+    auto& right = channels[RIGHT];
+
+    for (int blockStart = 0; blockStart < numSamples; blockStart += smoothed.getMaxBlockSize())
+    {
+        const int n = std::min(smoothed.getMaxBlockSize(), numSamples - blockStart);
+
+        // スリープ中は無音でない入力が来るまで DSP を通さない
+        const bool inputSilent = isSilent(inL + blockStart, n) && (blockMono || isSilent(inR + blockStart, n));
+        if (inputSilent && sleeping.load(std::memory_order_relaxed))
+        {
+            processSleeping(outL + blockStart, outR + blockStart, n, params);
+            continue;
+        }
+        sleeping.store(false, std::memory_order_relaxed);
+
+        // パラメーターランプ: 動いているものだけブロック分展開
+        smoothed.beginBlock(params, n);
+        blockStatic = smoothed.isBlockStatic();
+        blockLength = n;
+        blockInput[LEFT] = inL + blockStart;
+        blockInput[RIGHT] = blockMono ? nullptr : inR + blockStart;
+        // ブロック先頭で全パラメーターを確定。静止ブロックなら段の処理中は触らない
+        applyAllParameters(0);
+
+        // IR の差し替え（フェードを含む）はブロック境界で両チャンネルまとめて
+        earlyReflections.beginBlock(n);
+        blockEarly = earlyReflections.isActive();
+
+        // クロスフェード値をブロック分展開し、各ネットワークが鳴る区間を求める
+        dualMonoStart = trueStereoStart = n;
+        dualMonoEnd = trueStereoEnd = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            blendBuffer[static_cast<size_t>(i)] = trueStereoBlend;
+            if (trueStereoBlend < 1.0f)
+            {
+                dualMonoStart = std::min(dualMonoStart, i);
+                dualMonoEnd = i + 1;
+            }
+            if (trueStereoBlend > 0.0f)
+            {
+                trueStereoStart = std::min(trueStereoStart, i);
+                trueStereoEnd = i + 1;
+            }
+
+            if (trueStereoBlend != trueStereoTarget)
+                trueStereoBlend = trueStereoTarget > trueStereoBlend
+                    ? std::min(trueStereoBlend + trueStereoBlendStep, trueStereoTarget)
+                    : std::max(trueStereoBlend - trueStereoBlendStep, trueStereoTarget);
+        }
+
+        // モノ入力: 入力段はLだけ処理し、Rは同じドライ信号と弓圧を使う
+        if (blockMono)
+        {
+            processChannelInput(LEFT, blockInput[LEFT], n);
+            std::copy(left.dry.begin(), left.dry.begin() + n, right.dry.begin());
+            std::copy(left.bowEnv.begin(), left.bowEnv.begin() + n, right.bowEnv.begin());
+        }
+
+        // === L/R チェーン（並列時はRをワーカーへ） ===
+        // ワーカーの持ち時間は L チェーンと同じだけの待ち。超えたら（プリエンプトされたなど）しばらく直列
+        if (parallel && n >= PARALLEL_MIN_BLOCK && parallelBackoff <= 0)
+        {
+            const auto submitted = std::chrono::steady_clock::now();
+            chainWorker.submit(&AbyssVerbEngine::processRightChannel, this);
+            processChannel(LEFT);
+            const auto leftDone = std::chrono::steady_clock::now();
+            if (! chainWorker.wait(leftDone + (leftDone - submitted)))
+                parallelBackoff = parallelBackoffSamples;
+        }
+        else
+        {
+            processChannel(LEFT);
+            processChannel(RIGHT);
+            parallelBackoff = std::max(parallelBackoff - n, 0);
+        }
+
+        // === 合流: トゥルーステレオ → ウェット合成 → DC除去 → リミッター → ミックス ===
+        processStereoReverb(n);
+        processOutput(outL + blockStart, outR + blockStart, n);
+
+        updateSilence(inputSilent, outL + blockStart, outR + blockStart, n);
+    }
+
+    if (visualizer.isDue(numSamples))
+        publishVisualizerFrame();
+
+#if ABYSSVERB_PROFILING
+    profiler.endBlock(numSamples, sleeping.load(std::memory_order_relaxed));
+#endif
+}
+
+//==============================================================================
+void AbyssVerbEngine::updateSilence(bool inputSilent, const float* outL, const float* outR, int numSamples)
+{
+    if (! inputSilent || ! isSilent(outL, numSamples) || ! isSilent(outR, numSamples))
+    {
+        quietSamples = 0;
+        return;
+    }
+
+    // 初期反射は入力が止まってから IR の長さだけ鳴り続ける
+    const int hold = silenceHoldSamples + (blockEarly ? earlyReflections.getTailSamples() : 0);
+    quietSamples = std::min(quietSamples + numSamples, hold);
+    if (quietSamples < hold)
+        return;
+
+    // 出力に現れていない分（ディレイ・FDN のラインの中身）も尽きているか。
+    // 鳴っていない側のネットワークは切替時に消去されるので見なくてよい
+    for (const auto& c : channels)
+        if (! c.delay.isSilent() || (trueStereoBlend < 1.0f && ! c.reverb.isSilent()))
+            return;
+    if (trueStereoBlend > 0.0f && ! reverbStereo.isSilent())
+        return;
+
+    sleeping.store(true, std::memory_order_relaxed);
+}
+
+void AbyssVerbEngine::clearActivatingNetwork(float trueStereoTarget)
+{
+    if (trueStereoTarget > 0.5f && trueStereoBlend <= 0.0f)
+        reverbStereo.clear();
+    else if (trueStereoTarget < 0.5f && trueStereoBlend >= 1.0f)
+    {
+        channels[LEFT].reverb.clear();
+        channels[RIGHT].reverb.clear();
+    }
+}
+
+void AbyssVerbEngine::processSleeping(float* outL, float* outR, int numSamples, const ParamSnapshot& params)
+{
+    // 起きた時に最新の値から始められるよう、ランプ・IR のフェード・トゥルーステレオ切替は進めておく
+    smoothed.beginBlock(params, numSamples);
+    earlyReflections.beginBlock(numSamples);
+    // 切替はフェードせずに飛ばすが、鳴り始める側の古い残響はクロスフェード時と同じく消す
+    const float trueStereoTarget = params.isOn(Param::trueStereo) ? 1.0f : 0.0f;
+    clearActivatingNetwork(trueStereoTarget);
+    trueStereoBlend = trueStereoTarget;
+
+    std::fill(outL, outL + numSamples, 0.0f);
+    std::fill(outR, outR + numSamples, 0.0f);
+}
+
+void AbyssVerbEngine::publishVisualizerFrame()
+{
+    VisualizerFrame frame;
+    frame.sleeping = sleeping.load(std::memory_order_relaxed);
+
+    // ラインのエネルギーは鳴っているネットワークだけ読む（デュアルモノは L/R の平均）
+    const float blend = trueStereoBlend;
+    if (blend < 1.0f)
+    {
+        std::array<float, VisualizerFrame::NUM_LINES> energyL, energyR;
+        channels[LEFT].reverb.getLineEnergies(energyL.data());
+        channels[RIGHT].reverb.getLineEnergies(energyR.data());
+        for (size_t i = 0; i < energyL.size(); ++i)
+            frame.lineEnergy[i] = (1.0f - blend) * 0.5f * (energyL[i] + energyR[i]);
+    }
+    if (blend > 0.0f)
+    {
+        std::array<float, VisualizerFrame::NUM_LINES> energy;
+        reverbStereo.getLineEnergies(energy.data());
+        for (size_t i = 0; i < energy.size(); ++i)
+            frame.lineEnergy[i] += blend * energy[i];
+    }
+
+    for (size_t ch = 0; ch < channels.size(); ++ch)
+    {
+        const auto& c = channels[ch];
+        for (int t = 0; t < VisualizerFrame::NUM_TAPS; ++t)
+            frame.tapGain[ch][static_cast<size_t>(t)] = c.delay.getTapGain(t);
+        // モノ入力では R のエンベロープは動かさず L のものを使っている
+        frame.envelope[ch] = (blockMono ? channels[LEFT] : c).envFollower.getEnvelope();
+    }
+
+    visualizer.publish(frame);
+}
+
+bool AbyssVerbEngine::isSilent(const float* data, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        if (std::abs(data[i]) > SILENCE_LEVEL)
+            return false;
+    return true;
+}
+
+double AbyssVerbEngine::getTailLengthSeconds(const ParamSnapshot& params) const
+{
+    // 各段の減衰の速さ [dB/s]。ディレイ → 初期反射 → リバーブは直列なので、全体は遅い方の速さで
+    // 減衰する（和を取ると最悪同士が重なって数分になる）
+
+    // 消失ディレイ: 1周（最長タップ、R は 1.05 倍）ごとに feedback 倍以下になる
+    const double echoSeconds = params[Param::delayTime] * 1.05 / 1000.0;
+    const double feedback = static_cast<double>(params[Param::delayFeedback]);
+    const double delayRate = feedback > 0.0 ? -20.0 * std::log10(feedback) / echoSeconds
+                                            : std::numeric_limits<double>::infinity();
+
+    // 深淵リバーブ: reverbDecay は RT60（60dB 減衰する時間）。帯域別の倍率のうち長い方で決まる
+    const double longestBand = std::max(params[Param::reverbLowDecay], params[Param::reverbHighDecay]);
+    const double reverbRate = 60.0 / (params[Param::reverbDecay] * longestBand);
+
+    // 最初のエコーと IR の長さだけ遅れて減衰が始まる
+    const double tail = echoSeconds + earlyReflections.getLengthSeconds()
+                      + TAIL_DECAY_DB / std::min(delayRate, reverbRate);
+    return std::min(tail, MAX_TAIL_SECONDS);
+}
+
+//==============================================================================
+void AbyssVerbEngine::processChannel(int ch)
+{
+    if (! blockMono)
+        processChannelInput(ch, blockInput[ch], blockLength);
+    processChannelWet(ch, blockLength);
+}
+
+void AbyssVerbEngine::processRightChannel(void* engine)
+{
+    // ワーカーが実行する時は呼び出し元の FTZ/DAZ が効かないので、ここで同じ数値条件にする
+    ScopedFlushDenormals noDenormals;
+    static_cast<AbyssVerbEngine*>(engine)->processChannel(RIGHT);
+}
+
+void AbyssVerbEngine::processChannelInput(int ch, const float* input, int numSamples)
+{
+    auto& c = channels[static_cast<size_t>(ch)];
+    float* dry = c.dry.data();
+    float* bowEnv = c.bowEnv.data();
+
+    // === 入力調整 ===
+    {
+        ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::conditioner, ch);
+        runStage(! blockStatic && isConditionerRamping(), numSamples, 0, numSamples,
+                 [&](int from, int) { applyConditionerParameters(ch, from); },
+                 [&](int start, int len) { c.conditioner.process(input + start, dry + start, len); });
+    }
+
+    // === エンベロープ追跡 ===
+    ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::envelope, ch);
+    c.envFollower.process(dry, bowEnv, numSamples);
+
+    // 弓圧感度の適用
+    const float* sensitivityRamp = smoothed.getRampBuffer(Param::bowSensitivity);
+    const float sensitivity = smoothed.get(Param::bowSensitivity, 0);
+    for (int i = 0; i < numSamples; ++i)
+        bowEnv[i] = std::clamp(bowEnv[i] * paramAt(sensitivityRamp, sensitivity, i) * 3.0f, 0.0f, 1.0f);
+}
+
+void AbyssVerbEngine::processChannelWet(int ch, int numSamples)
+{
+    auto& c = channels[static_cast<size_t>(ch)];
+    const float* dry = c.dry.data();
+    const float* bowEnv = c.bowEnv.data();
+    float* delayOut = c.delayOut.data();
+    float* earlyOut = c.earlyOut.data();
+    float* reverbIn = c.reverbIn.data();
+    float* reverbOut = c.reverbOut.data();
+
+    // === ディレイ（弓圧反応付き） ===
+    {
+        ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::delay, ch);
+        runStage(! blockStatic && isDelayRamping(), numSamples, 0, numSamples,
+                 [&](int from, int length) { applyDelayParameters(ch, from, length); },
+                 [&](int start, int len) { c.delay.process(dry + start, bowEnv + start, delayOut + start, len); });
+    }
+
+    // === リバーブ入力（ドライ + ディレイ） ===
+    const float* delayMixRamp = smoothed.getRampBuffer(Param::delayMix);
+    const float delayMix = smoothed.get(Param::delayMix, 0);
+    for (int i = 0; i < numSamples; ++i)
+        reverbIn[i] = dry[i] + delayOut[i] * paramAt(delayMixRamp, delayMix, i) * 0.7f;
+
+    // === 初期反射（IR があるときだけ）: FDN の入力に足し、リバーブ出力にも直接加える ===
+    if (blockEarly)
+    {
+        ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::early, ch);
+        earlyReflections.process(ch, reverbIn, earlyOut, numSamples);
+
+        const float* earlyLevelRamp = smoothed.getRampBuffer(Param::earlyLevel);
+        const float earlyLevel = smoothed.get(Param::earlyLevel, 0);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            earlyOut[i] *= paramAt(earlyLevelRamp, earlyLevel, i);
+            reverbIn[i] += earlyOut[i];
+        }
+    }
+
+    // === デュアルモノ: 左右独立の2ネットワーク（トゥルーステレオ側は合流後に加算） ===
+    {
+        ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::reverb, ch);
+        for (int i = 0; i < numSamples; ++i)
+            reverbOut[i] = 0.0f;
+        runStage(! blockStatic && isReverbRamping(), numSamples, dualMonoStart, dualMonoEnd,
+                 [&](int from, int length) { applyReverbParameters(c.reverb, from, length); },
+                 [&](int start, int len) { c.reverb.process(reverbIn + start, bowEnv + start, reverbOut + start, len); });
+
+        for (int i = dualMonoStart; i < dualMonoEnd; ++i)
+            reverbOut[i] *= 1.0f - blendBuffer[static_cast<size_t>(i)];
+    }
+
+    if (blockEarly)
+        for (int i = 0; i < numSamples; ++i)
+            reverbOut[i] += earlyOut[i];
+}
+
+void AbyssVerbEngine::processStereoReverb(int numSamples)
+{
+    if (trueStereoEnd <= trueStereoStart)
+        return;
+
+    ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::reverb, LEFT);
+    auto& left = channels[LEFT];
+    auto& right = channels[RIGHT];
+    const int start = trueStereoStart, end = trueStereoEnd;
+
+    // トゥルーステレオ: 1つのネットワークで左右を拡散（モノ入力時はモノ→ステレオ）
+    for (int i = start; i < end; ++i)
+    {
+        const auto s = static_cast<size_t>(i);
+        stereoEnv[s] = 0.5f * (left.bowEnv[s] + right.bowEnv[s]);
+        if (blockMono)
+            stereoIn[s] = 0.5f * (left.reverbIn[s] + right.reverbIn[s]);
+    }
+
+    runStage(! blockStatic && isReverbRamping(), numSamples, start, end,
+             [&](int from, int length) { applyReverbParameters(reverbStereo, from, length); },
+             [&](int from, int len)
+             {
+                 if (blockMono)
+                     reverbStereo.processMonoToStereo(stereoIn.data() + from, stereoEnv.data() + from,
+                                                      stereoOutL.data() + from, stereoOutR.data() + from, len);
+                 else
+                     reverbStereo.processStereo(left.reverbIn.data() + from, right.reverbIn.data() + from,
+                                                stereoEnv.data() + from,
+                                                stereoOutL.data() + from, stereoOutR.data() + from, len);
+             });
+
+    for (int i = start; i < end; ++i)
+    {
+        const auto s = static_cast<size_t>(i);
+        left.reverbOut[s] += stereoOutL[s] * blendBuffer[s];
+        right.reverbOut[s] += stereoOutR[s] * blendBuffer[s];
+    }
+}
+
+void AbyssVerbEngine::processOutput(float* outL, float* outR, int numSamples)
+{
+    ABYSSVERB_PROFILE_STAGE(profiler, ProfileStage::output, LEFT);
+    using P = Param;
+    const OutputStage::Gain reverbMix { smoothed.getRampBuffer(P::reverbMix), smoothed.get(P::reverbMix, 0) };
+    const OutputStage::Gain delayMix  { smoothed.getRampBuffer(P::delayMix),  smoothed.get(P::delayMix, 0) };
+    const OutputStage::Gain masterMix { smoothed.getRampBuffer(P::masterMix), smoothed.get(P::masterMix, 0) };
+
+    float* outputs[2] = { outL, outR };
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        auto& c = channels[static_cast<size_t>(ch)];
+        float* wet = c.reverbOut.data(); // ウェット信号はリバーブ出力のバッファ上で組み立てる
+
+        // === ウェット信号合成 ===
+        kernels->wetSum(wet, c.delayOut.data(), reverbMix, delayMix, numSamples);
+
+        // === DCブロッカー ===
+        c.dcBlocker.process(wet, wet, numSamples);
+
+        // === ソフトリミッター（バイオリンの音をクリップさせない） ===
+        kernels->softClip(wet, numSamples);
+
+        // === ドライ/ウェットミックス ===
+        kernels->mix(c.dry.data(), wet, outputs[ch], masterMix, numSamples);
+    }
+}
+
+//==============================================================================
+bool AbyssVerbEngine::isConditionerRamping() const
+{
+    using P = Param;
+    return smoothed.isRamping(P::piezoCorrect) || smoothed.isRamping(P::bodyResonance)
+        || smoothed.isRamping(P::brightness);
+}
+
+bool AbyssVerbEngine::isReverbRamping() const
+{
+    using P = Param;
+    return smoothed.isRamping(P::reverbDecay) || smoothed.isRamping(P::reverbDampHigh)
+        || smoothed.isRamping(P::reverbDampLow) || smoothed.isRamping(P::reverbModDepth)
+        || smoothed.isRamping(P::reverbModRate) || smoothed.isRamping(P::reverbLowDecay)
+        || smoothed.isRamping(P::reverbHighDecay) || smoothed.isRamping(P::reverbCrossover);
+}
+
+bool AbyssVerbEngine::isDelayRamping() const
+{
+    using P = Param;
+    return smoothed.isRamping(P::delayTime) || smoothed.isRamping(P::delayFeedback)
+        || smoothed.isRamping(P::vanishRate) || smoothed.isRamping(P::degradeAmount)
+        || smoothed.isRamping(P::driftAmount) || smoothed.isRamping(P::detuneAmount);
+}
+
+void AbyssVerbEngine::applyAllParameters(int i)
+{
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        applyConditionerParameters(ch, i);
+        applyDelayParameters(ch, i);
+        applyReverbParameters(channels[static_cast<size_t>(ch)].reverb, i);
+    }
+    applyReverbParameters(reverbStereo, i);
+}
+
+void AbyssVerbEngine::applyConditionerParameters(int ch, int i)
+{
+    using P = Param;
+    // コンディショナーは目標値の記録のみ。係数はコントロールレートで更新
+    channels[static_cast<size_t>(ch)].conditioner.setParameters(smoothed.get(P::piezoCorrect, i),
+                                                                smoothed.get(P::bodyResonance, i),
+                                                                smoothed.get(P::brightness, i));
+}
+
+void AbyssVerbEngine::applyReverbParameters(AbyssFDNReverb& reverb, int i, int glideSamples)
+{
+    using P = Param;
+    // 変調の深さは区間の終わりの値へ線形に動かす（途中の値はランプと端点で一致する）
+    const int glideEnd = i + std::max(glideSamples - 1, 0);
+    reverb.setParameters(smoothed.get(P::reverbDecay, i), smoothed.get(P::reverbDampHigh, i),
+                         smoothed.get(P::reverbDampLow, i), smoothed.get(P::reverbModDepth, glideEnd),
+                         smoothed.get(P::reverbModRate, i), glideSamples);
+    reverb.setDecayShelf(smoothed.get(P::reverbLowDecay, i), smoothed.get(P::reverbHighDecay, i),
+                         smoothed.get(P::reverbCrossover, i));
+}
+
+void AbyssVerbEngine::applyDelayParameters(int ch, int i, int glideSamples)
+{
+    using P = Param;
+    // ディレイタイムは区間の終わりの値へ線形に動かす（途中の値はランプと端点で一致する）
+    const float delayTime     = smoothed.get(P::delayTime, i + std::max(glideSamples - 1, 0));
+    const float delayFeedback = smoothed.get(P::delayFeedback, i);
+    const float vanishRate    = smoothed.get(P::vanishRate, i);
+    const float degradeAmount = smoothed.get(P::degradeAmount, i);
+    const float driftAmount   = smoothed.get(P::driftAmount, i);
+    const float detuneAmount  = smoothed.get(P::detuneAmount, i);
+
+    if (ch == LEFT)
+        channels[LEFT].delay.setParameters(delayTime, delayFeedback, vanishRate,
+                                           degradeAmount, driftAmount, detuneAmount, glideSamples);
+    else
+        // R側をわずかにずらす → ステレオ幅
+        channels[RIGHT].delay.setParameters(delayTime * 1.05f, delayFeedback, vanishRate,
+                                            degradeAmount, driftAmount * 1.12f, detuneAmount * 0.9f, glideSamples);
+}
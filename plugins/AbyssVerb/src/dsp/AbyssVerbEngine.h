@@ -0,0 +1,269 @@
+#pragma once
+#include "AbyssVerbParameters.h"
+#include "SmoothedParameters.h"
+#include "ViolinInputConditioner.h"
+#include "EnvelopeFollower.h"
+#include "AbyssFDNReverb.h"
+#include "VanishingDelay.h"
+#include "EarlyReflections.h"
+#include "DcBlocker.h"
+#include "OutputStage.h"
+#include "ParallelChainWorker.h"
+#include "DspProfiler.h"
+#include "VisualizerFeed.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+// AbyssVerb 処理グラフ
+// コンディショナー → エンベロープ → 消失ディレイ → 初期反射 → 深淵リバーブ → DC除去/リミッター → ミックス
+// JUCE に依存しないので、プラグイン・ベンチマーク・オフラインツールが同じコアを使う
+//
+// 各段はブロック単位（process(in, out, n)）で順に通し、中間信号は prepare で確保した
+// スクラッチバッファに置く。サンプル単位で回るのはフィードバックを持つ段の内部だけ。
+// L/R のチェーン（コンディショナー → ディレイ → デュアルモノリバーブ）は最終ミックスまで
+// 互いに独立なので、並列モードでは R チェーンを事前起動したワーカーに渡し、
+// トゥルーステレオ・DC除去・ミックスの前で合流する
+//==============================================================================
+class AbyssVerbEngine
+{
+public:
+    // 並列チャンネルモードでワーカーに渡す最小ブロック長
+    static constexpr int PARALLEL_MIN_BLOCK = 256;
+
+    // 一度に処理する最大のブロック長（中間信号とランプバッファは最初の prepare でこの長さに確保する）
+    static constexpr int MAX_BLOCK_SIZE = 2048;
+
+    // 消失ディレイの既定の乱数シード（L/Rで別の消失パターンになるよう異なる値）
+    static constexpr std::uint32_t DEFAULT_SEED_LEFT = 42;
+    static constexpr std::uint32_t DEFAULT_SEED_RIGHT = 4242;
+
+    // パラメーターごとのランプ時間を決める（確保は prepare で）
+    AbyssVerbEngine();
+
+    // 全バッファを確保し、initialParams をランプなしで反映して状態を消去する
+    // maxBlockSize（MAX_BLOCK_SIZE で頭打ち）は一度に処理する長さ。process はこれより長いブロックも分割して処理する
+    // 2回目以降（ホストのレート・ブロック長の切替）は状態を消さずにテールを新しいレートへ移し、
+    // これまでに準備した最も高いレート（か MAX_PREPARED_SAMPLE_RATE）以下なら確保もしない
+    // （IR はレートが変わった時だけ作り直す）。
+    // 消すなら reset を呼ぶ
+    void prepare(double sampleRate, int maxBlockSize,
+                 const ParamSnapshot& initialParams = ParamSnapshot::defaults());
+
+    // 残響・ディレイのテールとフィルタ状態を消去（確保済みのメモリはそのまま）
+    void reset();
+
+    // inR == nullptr ならモノ入力（出力は常にステレオ）
+    // 入出力は同じバッファでもよい（インプレース処理）
+    void process(const float* inL, const float* inR, float* outL, float* outR,
+                 int numSamples, const ParamSnapshot& params);
+
+    // 並列チャンネルモードの切替（非オーディオスレッドから。既定はオフ、初回の有効化でワーカーを起動）
+    // PARALLEL_MIN_BLOCK 未満のブロックは受け渡しのコストが勝つので直列で処理する。
+    // リアルタイム処理では WorkerPriority::realtime を指定する。優先度を上げられなければ
+    // 並列にせず false を返す。R チェーンがワーカーの遅れで L チェーンの倍より長くかかったブロックの後は
+    // PARALLEL_BACKOFF_SECONDS のあいだ直列に戻す（出力はどちらでも同じ）
+    using WorkerPriority = ParallelChainWorker::Priority;
+    bool setParallelChannels(bool shouldRunInParallel, WorkerPriority priority = WorkerPriority::normal);
+    bool isParallelChannels() const { return parallelChannels.load(std::memory_order_relaxed); }
+
+    // ワーカースレッド上で呼ぶフック（ホストのオーディオワークグループへの参加など）。
+    // set は並列モードを有効にする前に、request はワークグループが変わるたびに（どのスレッドからでも）
+    void setWorkerThreadHook(ParallelChainWorker::JobFunction hook, void* context) { chainWorker.setThreadHook(hook, context); }
+    void requestWorkerThreadHook() { chainWorker.requestThreadHook(); }
+
+    // L/R の消失ディレイの乱数シード（非オーディオスレッドから。次のブロック先頭で反映し、
+    // 消失スケジュールをシードの初期状態からやり直す）。同じシード・入力・パラメーターなら
+    // 最初の prepare / reset からの出力は毎回同じになる
+    void setRandomSeeds(std::uint32_t left, std::uint32_t right);
+    std::uint32_t getRandomSeed(int channel) const { return seeds[channel != 0 ? 1 : 0].load(std::memory_order_relaxed); }
+
+    // ディレイ・リバーブの変調読み出しの補間品質（非オーディオスレッドから。次のブロックから反映）
+    void setInterpolationQuality(InterpolationQuality quality) { interpolation.store(quality, std::memory_order_relaxed); }
+    InterpolationQuality getInterpolationQuality() const { return interpolation.load(std::memory_order_relaxed); }
+
+    // 初期反射の IR（非オーディオスレッドから。リサンプルと分割FFTは呼び出したスレッドで行い、
+    // オーディオスレッドへはロックなしで渡る）。空の IR で解除。IR が無ければ初期反射の段は通らない
+    void setEarlyReflectionsImpulseResponse(ImpulseResponse impulseResponse)
+    {
+        earlyReflections.setImpulseResponse(std::move(impulseResponse));
+    }
+
+    double getSampleRate() const { return sr; }
+
+    // prepare で選んだ命令セット別カーネル（環境変数 ABYSSVERB_SIMD で固定できる）
+    SimdVariant getSimdVariant() const { return kernels->variant; }
+
+    // 入力が止まってから出力が TAIL_DECAY_DB 下がるまでの時間（非オーディオスレッドから。MAX_TAIL_SECONDS で頭打ち）。
+    // params の残響時間・ディレイのフィードバックと IR の長さから見積もる
+    // （ホストのサスペンド判定とオフラインレンダーのテール長に使う。スリープは実際の無音で判定する）
+    double getTailLengthSeconds(const ParamSnapshot& params) const;
+
+    // スリープ中か: 入力が無音で、ディレイ・残響の状態と出力がすべて SILENCE_LEVEL 以下に
+    // なったら DSP を止めて無音を出力し、無音でない入力が来たブロックから再開する
+    // （状態は止めた時のまま残るので、再開時にクリックは出ない）
+    bool isSleeping() const { return sleeping.load(std::memory_order_relaxed); }
+
+    // 表示フィード: FDN のラインのエネルギー・消失タップのゲイン・弓圧エンベロープを
+    // VisualizerFeed::FRAME_RATE で間引いてロックなしのリングに積む。1つの非オーディオスレッドから
+    // 読み出す（読まれずに満杯の間は積まない。表示を開き直したら discard で古い分を捨てる）
+    bool popVisualizerFrame(VisualizerFrame& frame) { return visualizer.pop(frame); }
+    void discardVisualizerFrames() { visualizer.discard(); }
+
+#if ABYSSVERB_PROFILING
+    // DSP 負荷の計測（ABYSSVERB_PROFILING ビルドのみ）。process 1回ごとの段別の時間が
+    // ロックなしのリングに積まれるので、1つの非オーディオスレッドから読み出す（溢れた分は捨てる）
+    bool popProfileFrame(ProfileFrame& frame) { return profiler.pop(frame); }
+    long long getDroppedProfileFrames() const { return profiler.getDroppedFrames(); }
+#endif
+
+private:
+    // 入力・出力が無音のまま続いたらスリープを検討するまでの長さ（コンディショナー・DC除去の減衰分）
+    static constexpr double SILENCE_HOLD_SECONDS = 0.1;
+    static constexpr double PARALLEL_BACKOFF_SECONDS = 1.0;
+    // ランプ中のパラメーターを段へ反映する間隔。段が係数を作り直す間隔（コントロールレート）に合わせる
+    static constexpr int PARAMETER_INTERVAL = AbyssFDNReverb::CONTROL_INTERVAL;
+    static_assert(PARAMETER_INTERVAL == ViolinInputConditioner::CONTROL_INTERVAL,
+                  "the conditioner and the FDN should share the control interval");
+
+    // getTailLengthSeconds の基準: RT60 と同じ 60dB の減衰と、ホストへ報告する上限
+    static constexpr double TAIL_DECAY_DB = 60.0;
+    static constexpr double MAX_TAIL_SECONDS = 60.0;
+
+    // 片チャンネルの処理チェーンと、ブロック内の中間信号
+    struct Channel
+    {
+        ViolinInputConditioner conditioner;
+        EnvelopeFollower envFollower;
+        VanishingDelay delay;
+        AbyssFDNReverb reverb;
+        DcBlocker dcBlocker;
+
+        std::vector<float> dry, bowEnv, delayOut, earlyOut, reverbIn, reverbOut;
+    };
+
+    enum { LEFT, RIGHT };
+
+    // チェーン処理: 入力段（コンディショナー + 弓圧エンベロープ）と
+    // ウェット段（ディレイ + デュアルモノリバーブ）
+    void processChannelInput(int ch, const float* input, int numSamples);
+    // コンディショナーとエンベロープを今のレートで作り直す（状態も消える）
+    void prepareShortStages();
+    void processChannelWet(int ch, int numSamples);
+    void processChannel(int ch);
+    static void processRightChannel(void* engine);
+
+    // トゥルーステレオ切替で鳴り始める側のネットワーク（target 側）の古い残響を消す。
+    // ブレンドが反対側の端にいる時だけ（フェード中はどちらも鳴っているので触らない）
+    void clearActivatingNetwork(float trueStereoTarget);
+
+    // 合流後: トゥルーステレオリバーブと出力段
+    void processStereoReverb(int numSamples);
+    void processOutput(float* outL, float* outR, int numSamples);
+
+    // スリープ: 処理したブロックの入出力からテールの終わりを判定し、スリープ中のブロックは
+    // パラメーターのランプと IR の差し替えだけ進めて無音を出す
+    void updateSilence(bool inputSilent, const float* outL, const float* outR, int numSamples);
+    void processSleeping(float* outL, float* outR, int numSamples, const ParamSnapshot& params);
+    static bool isSilent(const float* data, int numSamples);
+
+    // 表示フィードへ現在の状態を1フレーム積む
+    void publishVisualizerFrame();
+
+    // 1段をブロック内の [start, end) に通す。パラメーターが静止していれば一括、
+    // ランプ中なら PARAMETER_INTERVAL ごとに apply(from, length) で反映し、その間をまとめて処理する
+    // （反映はブロック全体で行う）
+    template <typename ApplyFn, typename ProcessFn>
+    void runStage(bool ramping, int numSamples, int start, int end, ApplyFn&& apply, ProcessFn&& process)
+    {
+        if (! ramping)
+        {
+            if (end > start)
+                process(start, end - start);
+            return;
+        }
+
+        for (int from = 0; from < numSamples; from += PARAMETER_INTERVAL)
+        {
+            const int to = std::min(from + PARAMETER_INTERVAL, numSamples);
+            apply(from, to - from);
+            const int first = std::max(from, start), last = std::min(to, end);
+            if (last > first)
+                process(first, last - first);
+        }
+    }
+
+    // ランプ中のグループだけ PARAMETER_INTERVAL ごとに反映する（ブロック先頭では全グループを反映）
+    bool isConditionerRamping() const;
+    bool isDelayRamping() const;
+    bool isReverbRamping() const;
+    void applyAllParameters(int sampleInBlock);
+    void applyConditionerParameters(int ch, int sampleInBlock);
+    // glideSamples > 0 なら読み出し位置を動かすパラメーター（ディレイタイム、変調の深さ）は
+    // その長さをかけて sampleInBlock + glideSamples - 1 の値へ線形に動かす
+    void applyDelayParameters(int ch, int sampleInBlock, int glideSamples = 0);
+    void applyReverbParameters(AbyssFDNReverb& reverb, int sampleInBlock, int glideSamples = 0);
+
+    // パラメーターのブロック内の値（静止中はランプバッファがないので定数）
+    float paramAt(const float* ramp, float value, int i) const { return ramp != nullptr ? ramp[i] : value; }
+
+    double sr = 48000.0;
+    bool prepared = false;
+    const DspKernels* kernels = &SimdDispatch::baseline();
+
+    // パラメータースムージング
+    SmoothedParameters smoothed;
+
+    // ステレオペア
+    std::array<Channel, 2> channels;
+    AbyssFDNReverb reverbStereo; // トゥルーステレオ用（L/Rで1ネットワーク）
+
+    // 初期反射（L/R の畳み込み状態を内部に持ち、各チェーンから自分のチャンネルを処理する）
+    EarlyReflections earlyReflections;
+
+    // デュアルモノ(0) ↔ トゥルーステレオ(1) のクロスフェード（ブロック内の値を先に展開）
+    // 値は単調に動くので、各ネットワークが鳴る区間はブロック内で連続する
+    float trueStereoBlend = 0.0f;
+    float trueStereoBlendStep = 0.0f;
+    std::vector<float> blendBuffer;
+    int dualMonoStart = 0, dualMonoEnd = 0;     // blend < 1 の区間
+    int trueStereoStart = 0, trueStereoEnd = 0; // blend > 0 の区間
+
+    // トゥルーステレオ用スクラッチ
+    std::vector<float> stereoIn, stereoEnv, stereoOutL, stereoOutR;
+
+    // 現在のブロック（ワーカーと共有。submit 前に書き込む）
+    const float* blockInput[2] = { nullptr, nullptr };
+    int blockLength = 0;
+    bool blockStatic = true;
+    bool blockMono = false;
+    bool blockEarly = false;
+
+    // 乱数シード（setRandomSeeds → 次のブロック先頭で各ディレイへ）
+    std::atomic<std::uint32_t> seeds[2] { { DEFAULT_SEED_LEFT }, { DEFAULT_SEED_RIGHT } };
+    std::atomic<bool> seedsChanged { false };
+
+    std::atomic<InterpolationQuality> interpolation { InterpolationQuality::hermite };
+
+    // テール検出とスリープ（オーディオスレッド。sleeping は他スレッドから読む）
+    int quietSamples = 0;       // 入力・出力とも無音のまま続いたサンプル数
+    int silenceHoldSamples = 0;
+    std::atomic<bool> sleeping { false };
+
+    // 並列チャンネルモード
+    std::atomic<bool> parallelChannels { false };
+    ParallelChainWorker chainWorker;
+    double workerPeriodSeconds = 512.0 / 48000.0; // リアルタイムのワーカーに申告する周期（prepare のブロック長）
+    int parallelBackoffSamples = 0;               // PARALLEL_BACKOFF_SECONDS（サンプル）
+    int parallelBackoff = 0;                      // 直列に戻している残り（オーディオスレッド）
+
+    VisualizerFeed visualizer;
+
+#if ABYSSVERB_PROFILING
+    // 段別の負荷計測（スロットはチャンネル。合流後の段は LEFT）
+    DspProfiler profiler;
+#endif
+};
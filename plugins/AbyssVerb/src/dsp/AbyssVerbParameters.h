@@ -0,0 +1,100 @@
+#pragma once
+
+//==============================================================================
+// パラメーター定義 — ID・範囲・既定値を1か所にまとめ、列挙子で型安全に参照する
+// 並び順は paramSpecs と一致させること。先頭 NUM_SMOOTHED_PARAMS 個がスムージング対象
+//==============================================================================
+enum class Param : int
+{
+    // バイオリン入力
+    piezoCorrect, bodyResonance, brightness,
+    // リバーブ
+    reverbDecay, reverbDampHigh, reverbDampLow, reverbModDepth, reverbModRate, earlyLevel,
+    reverbLowDecay, reverbHighDecay, reverbCrossover,
+    // ディレイ
+    delayTime, delayFeedback, vanishRate, degradeAmount, driftAmount, detuneAmount,
+    // ミックス
+    reverbMix, delayMix, masterMix, bowSensitivity,
+    // モード（スムージングなし）
+    trueStereo,
+
+    NUM_PARAMS
+};
+
+constexpr int NUM_PARAMS = static_cast<int>(Param::NUM_PARAMS);
+constexpr int NUM_SMOOTHED_PARAMS = static_cast<int>(Param::trueStereo);
+
+struct ParamSpec
+{
+    Param param;
+    const char* id;
+    const char* name;
+    float minValue, maxValue, interval, skew;
+    float defaultValue;
+    bool isToggle;
+};
+
+inline constexpr ParamSpec paramSpecs[NUM_PARAMS] = {
+    // === バイオリン入力調整 ===
+    { Param::piezoCorrect,   "piezoCorrect",   "Piezo Correction", 0.0f,  1.0f,    0.01f, 1.0f,  0.6f,   false },
+    { Param::bodyResonance,  "bodyResonance",  "Body Resonance",   0.0f,  1.0f,    0.01f, 1.0f,  0.4f,   false },
+    { Param::brightness,     "brightness",     "Brightness",       0.0f,  1.0f,    0.01f, 1.0f,  0.5f,   false },
+    // === リバーブ ===
+    { Param::reverbDecay,    "reverbDecay",    "Abyss Depth",      0.5f,  45.0f,   0.1f,  0.35f, 8.0f,   false },
+    { Param::reverbDampHigh, "reverbDampHigh", "High Darkness",    0.0f,  0.95f,   0.01f, 1.0f,  0.65f,  false },
+    { Param::reverbDampLow,  "reverbDampLow",  "Low Warmth",       0.0f,  0.95f,   0.01f, 1.0f,  0.3f,   false },
+    { Param::reverbModDepth, "reverbModDepth", "Shimmer",          0.0f,  3.0f,    0.01f, 1.0f,  0.6f,   false },
+    { Param::reverbModRate,  "reverbModRate",  "Sway",             0.03f, 1.5f,    0.01f, 1.0f,  0.2f,   false },
+    { Param::earlyLevel,     "earlyLevel",     "Early Reflections", 0.0f, 1.0f,    0.01f, 1.0f,  0.5f,   false },
+    // 帯域別の減衰（Abyss Depth に掛ける倍率。1.0 / 1.0 でシェルフは働かない。倍率 1 がノブの中央）
+    { Param::reverbLowDecay,  "reverbLowDecay",  "Low Depth",      0.25f, 4.0f,    0.01f, 0.43f, 1.0f,   false },
+    { Param::reverbHighDecay, "reverbHighDecay", "High Depth",     0.25f, 4.0f,    0.01f, 0.43f, 1.0f,   false },
+    { Param::reverbCrossover, "reverbCrossover", "Depth Split",    200.0f, 6000.0f, 1.0f, 0.3f,  1500.0f, false },
+    // === ディレイ ===
+    { Param::delayTime,      "delayTime",      "Echo Time",        80.0f, 2000.0f, 1.0f,  0.45f, 500.0f, false },
+    { Param::delayFeedback,  "delayFeedback",  "Echo Sustain",     0.0f,  0.92f,   0.01f, 1.0f,  0.45f,  false },
+    { Param::vanishRate,     "vanishRate",     "Vanish",           0.0f,  0.7f,    0.01f, 1.0f,  0.25f,  false },
+    { Param::degradeAmount,  "degradeAmount",  "Fade Texture",     0.0f,  1.0f,    0.01f, 1.0f,  0.25f,  false },
+    { Param::driftAmount,    "driftAmount",    "Time Drift",       0.0f,  8.0f,    0.1f,  1.0f,  1.5f,   false },
+    { Param::detuneAmount,   "detuneAmount",   "Chorus Drift",     0.0f,  5.0f,    0.1f,  1.0f,  1.0f,   false },
+    // === ミックス ===
+    { Param::reverbMix,      "reverbMix",      "Abyss Mix",        0.0f,  1.0f,    0.01f, 1.0f,  0.45f,  false },
+    { Param::delayMix,       "delayMix",       "Echo Mix",         0.0f,  1.0f,    0.01f, 1.0f,  0.25f,  false },
+    { Param::masterMix,      "masterMix",      "Dry/Wet",          0.0f,  1.0f,    0.01f, 1.0f,  0.45f,  false },
+    // === 表現力 ===
+    { Param::bowSensitivity, "bowSensitivity", "Bow Sensitivity",  0.0f,  1.0f,    0.01f, 1.0f,  0.5f,   false },
+    // === モード ===
+    { Param::trueStereo,     "trueStereo",     "True Stereo",      0.0f,  1.0f,    1.0f,  1.0f,  0.0f,   true  },
+};
+
+constexpr bool paramSpecsMatchEnum()
+{
+    for (int i = 0; i < NUM_PARAMS; ++i)
+        if (static_cast<int>(paramSpecs[i].param) != i)
+            return false;
+    return true;
+}
+static_assert(paramSpecsMatchEnum(), "paramSpecs must be listed in Param order");
+
+inline const ParamSpec& getParamSpec(Param p) { return paramSpecs[static_cast<int>(p)]; }
+
+//==============================================================================
+// パラメータースナップショット — ブロック先頭で全パラメーターを1回で読み込んだ値
+//==============================================================================
+struct ParamSnapshot
+{
+    float values[NUM_PARAMS] = {};
+
+    float operator[](Param p) const { return values[static_cast<int>(p)]; }
+    float& operator[](Param p)      { return values[static_cast<int>(p)]; }
+
+    bool isOn(Param p) const { return (*this)[p] >= 0.5f; }
+
+    static ParamSnapshot defaults()
+    {
+        ParamSnapshot snapshot;
+        for (int i = 0; i < NUM_PARAMS; ++i)
+            snapshot.values[i] = paramSpecs[i].defaultValue;
+        return snapshot;
+    }
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include "SimdFloat4.h"
+
+//==============================================================================
+// DCブロッカー — 1次ハイパス (y = x - x1 + R * y1)
+// 4サンプルずつ漸化式を展開して SIMD で解く:
+//   y[n+k] = Σ_{j<=k} R^(k-j) d[n+j] + R^(k+1) y[n-1]   (d = x - x1)
+// 加算順序が変わるだけなので、スカラー版との差は丸め誤差（~1e-7 相対）
+//==============================================================================
+class DcBlocker
+{
+public:
+    static constexpr float COEFF = 0.9975f;
+
+    void reset() { x1 = y1 = 0.0f; }
+
+    // ブロック処理（in == out 可、アライメント不要）
+    void process(const float* input, float* output, int numSamples)
+    {
+        constexpr float R = COEFF, R2 = R * R, R3 = R2 * R, R4 = R3 * R;
+        // 下三角行列の列（d[n+j] が y[n+k] に寄与する係数）と y[n-1] の係数
+        const float columns[5][4] = { { 1.0f, R,    R2,   R3   },
+                                      { 0.0f, 1.0f, R,    R2   },
+                                      { 0.0f, 0.0f, 1.0f, R    },
+                                      { 0.0f, 0.0f, 0.0f, 1.0f },
+                                      { R,    R2,   R3,   R4   } };
+        const auto col0 = SimdFloat4::loadUnaligned(columns[0]);
+        const auto col1 = SimdFloat4::loadUnaligned(columns[1]);
+        const auto col2 = SimdFloat4::loadUnaligned(columns[2]);
+        const auto col3 = SimdFloat4::loadUnaligned(columns[3]);
+        const auto feedback = SimdFloat4::loadUnaligned(columns[4]);
+
+        float x = x1, y = y1;
+        int i = 0;
+        for (; i + SimdFloat4::SIZE <= numSamples; i += SimdFloat4::SIZE)
+        {
+            const auto in = SimdFloat4::loadUnaligned(input + i);
+            const auto d = in - SimdFloat4::shiftIn(x, in);
+
+            const auto out = SimdFloat4::splat<0>(d) * col0 + SimdFloat4::splat<1>(d) * col1
+                           + SimdFloat4::splat<2>(d) * col2 + SimdFloat4::splat<3>(d) * col3
+                           + SimdFloat4::broadcast(y) * feedback;
+            out.storeUnaligned(output + i);
+
+            x = in.get<3>();
+            y = out.get<3>();
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const float in = input[i];
+            y = in - x + COEFF * y;
+            x = in;
+            output[i] = y;
+        }
+
+        x1 = x;
+        y1 = y;
+    }
+
+private:
+    float x1 = 0.0f, y1 = 0.0f;
+};
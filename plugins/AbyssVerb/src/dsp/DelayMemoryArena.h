@@ -0,0 +1,160 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+//==============================================================================
+// ディレイメモリアリーナ — 複数のディレイラインを1つのアラインド領域に確保
+// 各ラインは2のべき乗長（インデックスはビットマスク）で、末尾のガード領域に
+// 先頭サンプルをミラーするため、補間の連続読み出しにラップ判定が要らない
+// 確保した長さ（capacity）の内側で、今のレートで使う長さ（mask + 1）だけを読み書き・消去する。
+// 容量に収まる長さへの切替は確保し直さず、中身は Line::setSize / resample で新しい長さ・レートへ移す
+//==============================================================================
+class DelayMemoryArena
+{
+public:
+    static constexpr int GUARD = 8;         // 補間が idx から先読みできるサンプル数（8点sinc まで）
+    static constexpr int ALIGN_FLOATS = 16; // 64バイト境界
+
+    struct Line
+    {
+        float* data = nullptr;
+        int mask = 0;     // 使っている長さ - 1
+        int capacity = 0; // 確保した長さ（2のべき乗、mask + 1 以上）
+
+        int size() const { return mask + 1; }
+
+        void write(int pos, float value)
+        {
+            data[pos] = value;
+            if (pos < GUARD)
+                data[pos + mask + 1] = value;
+        }
+
+        // 任意の（負も可）インデックスから GUARD 個の連続サンプル
+        const float* tap(int index) const { return data + (index & mask); }
+
+        // 使う長さを newSize（2のべき乗、capacity 以下）に切り替える（その場で、確保なし）。
+        // writePos の直前の履歴を新しい長さに収まる分だけ残し（伸ばした分は 0）、writePos を直す
+        void setSize(int& writePos, int newSize)
+        {
+            const int oldSize = size();
+            if (newSize == oldSize)
+                return;
+
+            // 最も古いサンプルを先頭へ（最新は oldSize - 1）
+            std::rotate(data, data + writePos, data + oldSize);
+            if (newSize < oldSize)
+            {
+                // 新しい側の newSize 個を先頭へ（2のべき乗なので newSize <= oldSize / 2 で重ならない）
+                std::copy(data + oldSize - newSize, data + oldSize, data);
+                writePos = 0;
+            }
+            else
+            {
+                std::fill(data + oldSize, data + newSize, 0.0f);
+                writePos = oldSize;
+            }
+            mask = newSize - 1;
+            std::copy(data, data + GUARD, data + newSize);
+        }
+
+        // レートの切替: 長さを newSize にし、直前 numSamples を ratio で並べ直す。
+        // 縮める時は古い長さのまま並べ直してから、伸ばす時は伸ばしてから並べ直す（どちらも履歴を失わない）
+        void changeRate(int& writePos, int numSamples, double ratio, int newSize)
+        {
+            if (newSize < size())
+            {
+                resample(writePos, numSamples, ratio);
+                setSize(writePos, newSize);
+            }
+            else
+            {
+                setSize(writePos, newSize);
+                resample(writePos, numSamples, ratio);
+            }
+        }
+
+        // writePos の直前 numSamples を、旧レート / 新レート = ratio で線形補間して並べ直す（その場で。
+        // 間引く時は新しい側から、伸ばす時は古い側から埋めれば、まだ読む値を上書きしない）。
+        // 書いた履歴より古い位置は 0 になる
+        void resample(int writePos, int numSamples, double ratio)
+        {
+            if (ratio == 1.0)
+                return;
+
+            numSamples = std::min(numSamples, size());
+            auto resampled = [&](int back)
+            {
+                const double position = back * ratio;
+                const int whole = static_cast<int>(position);
+                if (whole + 1 >= size())
+                    return 0.0f;
+                const float frac = static_cast<float>(position - whole);
+                const float a = data[(writePos - 1 - whole) & mask];
+                const float b = data[(writePos - 2 - whole) & mask];
+                return a + frac * (b - a);
+            };
+
+            if (ratio > 1.0)
+                for (int back = 0; back < numSamples; ++back)
+                    write((writePos - 1 - back) & mask, resampled(back));
+            else
+                for (int back = numSamples - 1; back >= 0; --back)
+                    write((writePos - 1 - back) & mask, resampled(back));
+        }
+    };
+
+    // minLengths[i] 以上の2のべき乗長の容量で numLines 本を一括確保し、0 で埋める（使う長さは容量いっぱい）。
+    // lines の容量がすでに足りていれば何もせずに false を返す（中身も使う長さもそのまま、確保もしない）
+    bool allocate(const int* minLengths, int numLines, Line* lines)
+    {
+        bool fits = ! storage.empty();
+        for (int i = 0; i < numLines && fits; ++i)
+            fits = lines[i].data != nullptr && lines[i].capacity >= nextPowerOfTwo(minLengths[i]);
+        if (fits)
+            return false;
+
+        size_t total = 0;
+        for (int i = 0; i < numLines; ++i)
+            total += paddedSize(nextPowerOfTwo(minLengths[i]));
+
+        storage.assign(total + ALIGN_FLOATS, 0.0f);
+
+        auto address = reinterpret_cast<std::uintptr_t>(storage.data());
+        const auto alignBytes = static_cast<std::uintptr_t>(ALIGN_FLOATS * sizeof(float));
+        float* base = storage.data() + ((alignBytes - address % alignBytes) % alignBytes) / sizeof(float);
+
+        for (int i = 0; i < numLines; ++i)
+        {
+            const int size = nextPowerOfTwo(minLengths[i]);
+            lines[i].data = base;
+            lines[i].mask = size - 1;
+            lines[i].capacity = size;
+            base += paddedSize(size);
+        }
+        return true;
+    }
+
+    // 各ラインの使っている長さ（とガード）だけを 0 で埋める。容量の残りは setSize で伸ばす時に埋める
+    static void clear(const Line* lines, int numLines)
+    {
+        for (int i = 0; i < numLines; ++i)
+            std::fill(lines[i].data, lines[i].data + lines[i].size() + GUARD, 0.0f);
+    }
+
+    static int nextPowerOfTwo(int n)
+    {
+        int size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+private:
+    std::vector<float> storage;
+
+    static size_t paddedSize(int size)
+    {
+        return static_cast<size_t>((size + GUARD + ALIGN_FLOATS - 1) / ALIGN_FLOATS * ALIGN_FLOATS);
+    }
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+ #include <emmintrin.h>
+ #define ABYSSVERB_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define ABYSSVERB_SIMD_NEON 1
+#endif
+
+// SIMD型とその上の小さな補間カーネルに付ける強制インライン。
+// ISA別にコンパイルする翻訳単位（DspKernels*.cpp）がこれらを関数として実体化しないので、
+// リンカが AVX 版の実体を共通の呼び出しに選んでしまうことがない（最適化なしのビルドでも）
+#if defined(_MSC_VER)
+ #define ABYSSVERB_SIMD_INLINE __forceinline
+#else
+ #define ABYSSVERB_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+//==============================================================================
+// DSPコア共通定義 — JUCE に依存しない数学定数とデノーマル対策
+//==============================================================================
+template <typename FloatType>
+struct DspConstants
+{
+    static constexpr FloatType pi = static_cast<FloatType>(3.141592653589793238L);
+};
+
+// 無音とみなす振幅（-100 dBFS、16bit の量子化ノイズより下）。
+// テール検出（ディレイ状態・出力の監視とスリープ）とテール長の見積もりで共通に使う
+constexpr float SILENCE_LEVEL = 1.0e-5f;
+
+// ディレイ・残響のラインと初期反射の FDL をあらかじめ確保しておくレート（CMake の
+// ABYSSVERB_MAX_SAMPLE_RATE。既定の 0 は指定なしで、ホストが準備したレートの長さだけ確保する）。
+// 確保済みの長さに収まるレートへの切替は確保し直さずにテールを変換して続ける
+#ifndef ABYSSVERB_MAX_SAMPLE_RATE
+ #define ABYSSVERB_MAX_SAMPLE_RATE 0
+#endif
+constexpr double MAX_PREPARED_SAMPLE_RATE = ABYSSVERB_MAX_SAMPLE_RATE;
+
+// 第1種変形ベッセル関数 I0（カイザー窓の係数計算用。級数展開、非オーディオスレッドで使う）
+inline double besselI0(double x)
+{
+    double term = 1.0, sum = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+//==============================================================================
+// デノーマル抑制 — スコープ内だけ FTZ/DAZ を有効にし、抜けたら元のモードに戻す
+// プラグイン外（ベンチマーク・オフラインツール）でも同じ数値条件で動かすため
+//==============================================================================
+class ScopedFlushDenormals
+{
+public:
+    ScopedFlushDenormals() noexcept
+    {
+#if ABYSSVERB_SIMD_SSE
+        previous = _mm_getcsr();
+        _mm_setcsr(previous | 0x8040); // FTZ | DAZ
+#elif ABYSSVERB_SIMD_NEON && defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        std::uint64_t fpcr;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        previous = fpcr;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr | (1ull << 24))); // FZ
+#endif
+    }
+
+    ~ScopedFlushDenormals() noexcept
+    {
+#if ABYSSVERB_SIMD_SSE
+        _mm_setcsr(static_cast<unsigned int>(previous));
+#elif ABYSSVERB_SIMD_NEON && defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        asm volatile("msr fpcr, %0" : : "r"(previous));
+#endif
+    }
+
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+
+private:
+    std::uint64_t previous = 0;
+};
@@ -0,0 +1,308 @@
+// インクルードガードなし: 命令セット別の翻訳単位（DspKernels.cpp / DspKernelsAvx2.cpp /
+// DspKernelsAvx512.cpp）が、名前空間 ABYSSVERB_KERNEL_NAMESPACE に
+//   WideFloat   — ブロック処理に使う最も広いSIMD型
+//   MediumFloat — ライン数が WideFloat の幅に満たない FDN に使う型（8レーンの積和にも使う）
+//   VARIANT     — この版の SimdVariant
+// を用意してからそれぞれ1回ずつインクルードし、<名前空間>::table を定義する。
+// 中身はすべてその名前空間に入るので、同じテンプレートを別の命令セットで実体化しても衝突しない。
+// 共有ヘッダーの関数は強制インラインのもの（SIMD型・補間カーネル）だけを使い、std::min などの
+// 関数テンプレートも呼ばない（弱シンボルとしてどの命令セットの実体が選ばれるか分からないため）。
+// ABYSSVERB_KERNEL_SHARED_BIQUAD を 1 にした版はバイクアッドをベースライン版と共有する
+#ifndef ABYSSVERB_KERNEL_NAMESPACE
+ #error "define ABYSSVERB_KERNEL_NAMESPACE before including DspKernelBodies.h"
+#endif
+
+#include "DspKernels.h"
+#include "OutputStage.h"
+#include "SimdFloat4.h"
+
+#if ABYSSVERB_KERNEL_SHARED_BIQUAD
+// サンプル間の再帰で広いレジスタを活かせないので、ベースライン版（DspKernels.cpp）をそのまま使う
+namespace DspKernelsBaseline
+{
+    void biquadCascade(const float* input, float* output, int numSamples,
+                       const DspKernels::BiquadSection* sections, int numSections);
+}
+
+namespace ABYSSVERB_KERNEL_NAMESPACE
+{
+    using DspKernelsBaseline::biquadCascade;
+}
+#endif
+
+namespace ABYSSVERB_KERNEL_NAMESPACE
+{
+    //==========================================================================
+    // FDN
+    //==========================================================================
+    // 8点の積和（SimdFloat4 2本の和を1回で。8レーン版の sum は同じ順序で足す）
+    inline float dot8(const float* x, const float* h)
+    {
+        if constexpr (MediumFloat::SIZE == 8)
+            return (MediumFloat::loadUnaligned(x) * MediumFloat::loadUnaligned(h)).sum();
+        else
+            return (SimdFloat4::loadUnaligned(x) * SimdFloat4::load(h)
+                  + SimdFloat4::loadUnaligned(x + 4) * SimdFloat4::load(h + 4)).sum();
+    }
+
+    // ラインをレーンに並べて補間する。多項式カーネルはタップを4個ずつ転置して読み、
+    // ポリフェーズは1本ずつ8点の積和（どちらも FractionalDelay::read と同じ演算順）
+    template <typename V, typename Kernel>
+    inline void interpolateLines(const DspKernels::FdnLines& lines, const float* const* taps,
+                                 const float* frac, float* outputs)
+    {
+        if constexpr (Kernel::POLYPHASE)
+        {
+            for (int l = 0; l < lines.numLines; ++l)
+            {
+                int phase = static_cast<int>(frac[l] * Kernel::PHASES + 0.5f);
+                phase = phase < 0 ? 0 : (phase > Kernel::PHASES ? Kernel::PHASES : phase);
+                outputs[l] = dot8(taps[l], lines.sincCoefficients + phase * Kernel::TAPS);
+            }
+        }
+        else
+        {
+            // TAPS を超えて読む分はディレイメモリのガード領域に収まる（GUARD >= 8）
+            for (int i = 0; i < lines.numLines; i += V::SIZE)
+            {
+                V y[(Kernel::TAPS + 3) / 4 * 4];
+                for (int k = 0; k < Kernel::TAPS; k += 4)
+                    V::transpose4(taps + i, k, y + k);
+                Kernel::evaluate(y, V::load(frac + i)).store(outputs + i);
+            }
+        }
+    }
+
+    // Hadamard フィードバック: レジスタ内の段をまとめて済ませ、残りの段はレジスタ単位のバタフライ
+    template <typename V>
+    inline void hadamardFeedback(const DspKernels::FdnLines& lines, const float* outputs, float* feedback)
+    {
+        const int n = lines.numLines;
+        for (int i = 0; i < n; i += V::SIZE)
+            V::hadamard(V::load(outputs + i)).store(feedback + i);
+
+        for (int half = V::SIZE; half < n; half <<= 1)
+            for (int block = 0; block < n; block += half * 2)
+                for (int i = block; i < block + half; i += V::SIZE)
+                {
+                    const V a = V::load(feedback + i);
+                    const V b = V::load(feedback + i + half);
+                    (a + b).store(feedback + i);
+                    (a - b).store(feedback + i + half);
+                }
+
+        const V scale = V::broadcast(lines.feedbackScale);
+        for (int i = 0; i < n; i += V::SIZE)
+            (V::load(feedback + i) * scale).store(feedback + i);
+    }
+
+    // RT60ゲイン（シェルフ有効時は低域/高域別）+ 2バンド周波数依存ダンピング
+    template <typename V>
+    inline void updateLines(const DspKernels::FdnLines& lines, const float* feedback,
+                            const float* injection, float* processed)
+    {
+        const V shelfK = V::broadcast(lines.shelfCoeff);
+        const V dampH = V::broadcast(lines.dampingHigh), dampHInv = V::broadcast(1.0f - lines.dampingHigh);
+        const V dampL = V::broadcast(lines.dampingLow), dampLInv = V::broadcast(1.0f - lines.dampingLow);
+        for (int i = 0; i < lines.numLines; i += V::SIZE)
+        {
+            const V fb = V::load(feedback + i);
+            V decayed;
+            if (lines.shelfActive)
+            {
+                const V shelf = V::load(lines.shelfState + i) + shelfK * (fb - V::load(lines.shelfState + i));
+                shelf.store(lines.shelfState + i);
+                decayed = shelf * V::load(lines.gainLo + i) + (fb - shelf) * V::load(lines.gainHi + i);
+            }
+            else
+            {
+                decayed = fb * V::load(lines.gainLo + i);
+            }
+
+            const V sig = decayed + V::load(injection + i);
+            const V hi = sig * dampHInv + V::load(lines.dampHi + i) * dampH;
+            const V lo = (sig - hi) * dampLInv + V::load(lines.dampLo + i) * dampL;
+            hi.store(lines.dampHi + i);
+            lo.store(lines.dampLo + i);
+            (hi + lo).store(processed + i);
+        }
+    }
+
+    template <typename V, typename Kernel>
+    inline void fdnTickLanes(const DspKernels::FdnLines& lines, const float* const* taps, const float* frac,
+                             const float* injection, float* outputs, float* processed)
+    {
+        alignas(64) float feedback[DspKernels::MAX_LINES];
+        interpolateLines<V, Kernel>(lines, taps, frac, outputs);
+        hadamardFeedback<V>(lines, outputs, feedback);
+        updateLines<V>(lines, feedback, injection, processed);
+    }
+
+    // ライン数を割り切る最も広いSIMD型で回す
+    template <typename Kernel>
+    void fdnTick(const DspKernels::FdnLines& lines, const float* const* taps, const float* frac,
+                 const float* injection, float* outputs, float* processed)
+    {
+        if (lines.numLines % WideFloat::SIZE == 0)
+            fdnTickLanes<WideFloat, Kernel>(lines, taps, frac, injection, outputs, processed);
+        else if (lines.numLines % MediumFloat::SIZE == 0)
+            fdnTickLanes<MediumFloat, Kernel>(lines, taps, frac, injection, outputs, processed);
+        else
+            fdnTickLanes<SimdFloat4, Kernel>(lines, taps, frac, injection, outputs, processed);
+    }
+
+#if ! ABYSSVERB_KERNEL_SHARED_BIQUAD
+    //==========================================================================
+    // バイクアッド直列 — 1サンプルを全段に通してから次へ進む（状態はレジスタに置いたまま、
+    // 段の間の中間バッファなし）。各段の演算は段ごとにブロックを通す場合と同じ
+    //==========================================================================
+    template <int NumSections>
+    inline void biquadSections(const float* input, float* output, int numSamples,
+                               const DspKernels::BiquadSection* sections)
+    {
+        float b0[NumSections], b1[NumSections], b2[NumSections], a1[NumSections], a2[NumSections];
+        float s1[NumSections], s2[NumSections];
+        for (int k = 0; k < NumSections; ++k)
+        {
+            b0[k] = sections[k].b[0]; b1[k] = sections[k].b[1]; b2[k] = sections[k].b[2];
+            a1[k] = sections[k].a[1]; a2[k] = sections[k].a[2];
+            s1[k] = *sections[k].z1;  s2[k] = *sections[k].z2;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float x = input[i];
+            for (int k = 0; k < NumSections; ++k)
+            {
+                const float y = b0[k] * x + s1[k];
+                s1[k] = b1[k] * x - a1[k] * y + s2[k];
+                s2[k] = b2[k] * x - a2[k] * y;
+                x = y;
+            }
+            output[i] = x;
+        }
+
+        for (int k = 0; k < NumSections; ++k)
+        {
+            *sections[k].z1 = s1[k];
+            *sections[k].z2 = s2[k];
+        }
+    }
+
+    void biquadCascade(const float* input, float* output, int numSamples,
+                       const DspKernels::BiquadSection* sections, int numSections)
+    {
+        switch (numSections)
+        {
+            case 1:  biquadSections<1>(input, output, numSamples, sections); break;
+            case 2:  biquadSections<2>(input, output, numSamples, sections); break;
+            case 3:  biquadSections<3>(input, output, numSamples, sections); break;
+            case 4:  biquadSections<4>(input, output, numSamples, sections); break;
+            default: break;
+        }
+    }
+#endif
+
+    //==========================================================================
+    // 出力段 — どれもサンプル間の依存がないので WideFloat の幅ずつ処理する（アライメント不要）
+    //==========================================================================
+    template <typename V>
+    inline V gainAt(const DspKernels::Gain& gain, int i)
+    {
+        return gain.ramp != nullptr ? V::loadUnaligned(gain.ramp + i) : V::broadcast(gain.value);
+    }
+
+    inline float gainAt(const DspKernels::Gain& gain, int i)
+    {
+        return gain.ramp != nullptr ? gain.ramp[i] : gain.value;
+    }
+
+    void wetSum(float* wet, const float* delay, DspKernels::Gain reverbMix, DspKernels::Gain delayMix, int numSamples)
+    {
+        using V = WideFloat;
+        int i = 0;
+        for (; i + V::SIZE <= numSamples; i += V::SIZE)
+            (V::loadUnaligned(wet + i) * gainAt<V>(reverbMix, i)
+             + V::loadUnaligned(delay + i) * gainAt<V>(delayMix, i)).storeUnaligned(wet + i);
+        for (; i < numSamples; ++i)
+            wet[i] = wet[i] * gainAt(reverbMix, i) + delay[i] * gainAt(delayMix, i);
+    }
+
+    void mix(const float* dry, const float* wet, float* out, DspKernels::Gain mixAmount, int numSamples)
+    {
+        using V = WideFloat;
+        const V one = V::broadcast(1.0f);
+        int i = 0;
+        for (; i + V::SIZE <= numSamples; i += V::SIZE)
+        {
+            const V m = gainAt<V>(mixAmount, i);
+            (V::loadUnaligned(dry + i) * (one - m) + V::loadUnaligned(wet + i) * m).storeUnaligned(out + i);
+        }
+        for (; i < numSamples; ++i)
+        {
+            const float m = gainAt(mixAmount, i);
+            out[i] = dry[i] * (1.0f - m) + wet[i] * m;
+        }
+    }
+
+    // e^-t（t >= 0）: 2^u（u = -t log2 e）を整数部 k と小数部 f に分け、
+    // 2^f を5次多項式（[0,1) の相対誤差ミニマックス 8e-8、p(0) = 1）、2^k を指数部で作る
+    template <typename V>
+    inline V expNegative(V t)
+    {
+        const V u = V::max(t * V::broadcast(-1.44269504f), V::broadcast(-126.0f));
+        const V k = V::floor(u);
+        const V f = u - k;
+
+        V p = V::broadcast(0.0018671467f);
+        p = p * f + V::broadcast(0.00901699505f);
+        p = p * f + V::broadcast(0.0557999384f);
+        p = p * f + V::broadcast(0.240164443f);
+        p = p * f + V::broadcast(0.693151312f);
+        p = p * f + V::broadcast(1.0f);
+
+        return p * V::pow2(k);
+    }
+
+    // ソフトリミッター（曲線と精度は OutputStage::softClipReference を参照）:
+    //   y = copysign(min(|x|, K) + W (1 - e^-(max(|x|-K, 0) / W)), x)   K = 0.9, W = 0.1
+    template <typename V>
+    inline V softClipLanes(V x)
+    {
+        const V knee = V::broadcast(OutputStage::SOFT_CLIP_KNEE);
+        const V width = V::broadcast(OutputStage::SOFT_CLIP_WIDTH);
+        const V a = V::abs(x);
+        const V over = V::max(a - knee, V::broadcast(0.0f)) * V::broadcast(1.0f / OutputStage::SOFT_CLIP_WIDTH);
+        return V::copySign(V::min(a, knee) + width * (V::broadcast(1.0f) - expNegative(over)), x);
+    }
+
+    // 端数もレーンを埋めて同じ近似で処理する（サンプルごとの結果はブロックの切り方によらない）
+    void softClip(float* data, int numSamples)
+    {
+        using V = WideFloat;
+        int i = 0;
+        for (; i + V::SIZE <= numSamples; i += V::SIZE)
+            softClipLanes(V::loadUnaligned(data + i)).storeUnaligned(data + i);
+        if (i < numSamples)
+        {
+            float tail[V::SIZE] = {};
+            for (int j = 0; i + j < numSamples; ++j)
+                tail[j] = data[i + j];
+            softClipLanes(V::loadUnaligned(tail)).storeUnaligned(tail);
+            for (int j = 0; i + j < numSamples; ++j)
+                data[i + j] = tail[j];
+        }
+    }
+
+    //==========================================================================
+    extern const DspKernels table;
+    const DspKernels table = {
+        VARIANT,
+        { fdnTick<FractionalDelay::Linear>, fdnTick<FractionalDelay::Hermite>,
+          fdnTick<FractionalDelay::Lagrange>, fdnTick<FractionalDelay::Sinc> },
+        biquadCascade,
+        wetSum,
+        mix,
+        softClip
+    };
+}
@@ -0,0 +1,177 @@
+#include "DspKernels.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define ABYSSVERB_X86_CPUID 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+ #include <cpuid.h>
+ #define ABYSSVERB_X86_CPUID 1
+#endif
+
+//==============================================================================
+// ベースライン版（この翻訳単位は既定のコンパイルオプションのまま）
+//==============================================================================
+namespace DspKernelsBaseline
+{
+    using WideFloat = SimdFloat4;
+    using MediumFloat = SimdFloat4;
+    constexpr SimdVariant VARIANT = SimdDispatch::BASELINE;
+}
+
+#define ABYSSVERB_KERNEL_NAMESPACE DspKernelsBaseline
+#include "DspKernelBodies.h"
+#undef ABYSSVERB_KERNEL_NAMESPACE
+
+// 拡張命令版（CMake が x86 向けに DspKernelsAvx2.cpp / DspKernelsAvx512.cpp を加えた時だけ）
+#if ABYSSVERB_HAVE_AVX2_KERNELS
+namespace DspKernelsAvx2 { extern const DspKernels table; }
+#endif
+#if ABYSSVERB_HAVE_AVX512_KERNELS
+namespace DspKernelsAvx512 { extern const DspKernels table; }
+#endif
+
+namespace
+{
+#if ABYSSVERB_X86_CPUID && (ABYSSVERB_HAVE_AVX2_KERNELS || ABYSSVERB_HAVE_AVX512_KERNELS)
+    struct CpuFeatures
+    {
+        bool avx2 = false;
+        bool avx512 = false;
+    };
+
+    void cpuid(unsigned int leaf, unsigned int subLeaf, unsigned int registers[4])
+    {
+    #if defined(_MSC_VER)
+        int values[4];
+        __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subLeaf));
+        for (int i = 0; i < 4; ++i)
+            registers[i] = static_cast<unsigned int>(values[i]);
+    #else
+        if (! __get_cpuid_count(leaf, subLeaf, &registers[0], &registers[1], &registers[2], &registers[3]))
+            registers[0] = registers[1] = registers[2] = registers[3] = 0;
+    #endif
+    }
+
+    // XCR0: OS がコンテキスト切り替えで退避するレジスタ（YMM / ZMM を使ってよいか）
+    unsigned long long readXcr0()
+    {
+    #if defined(_MSC_VER)
+        return _xgetbv(0);
+    #else
+        unsigned int low = 0, high = 0;
+        __asm__ volatile ("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+        return (static_cast<unsigned long long>(high) << 32) | low;
+    #endif
+    }
+
+    CpuFeatures detectCpuFeatures()
+    {
+        CpuFeatures features;
+        unsigned int leaf0[4], leaf1[4], leaf7[4];
+        cpuid(0, 0, leaf0);
+        if (leaf0[0] < 7)
+            return features;
+        cpuid(1, 0, leaf1);
+        cpuid(7, 0, leaf7);
+
+        const bool osxsave = (leaf1[2] & (1u << 27)) != 0;
+        const bool avx = (leaf1[2] & (1u << 28)) != 0;
+        if (! osxsave || ! avx)
+            return features;
+
+        const unsigned long long xcr0 = readXcr0();
+        const bool ymmState = (xcr0 & 0x06) == 0x06;            // XMM + YMM
+        const bool zmmState = (xcr0 & 0xE6) == 0xE6;            // + opmask / ZMM0-15 上位 / ZMM16-31
+
+        features.avx2 = ymmState && (leaf7[1] & (1u << 5)) != 0;
+        features.avx512 = features.avx2 && zmmState && (leaf7[1] & (1u << 16)) != 0; // AVX-512F
+        return features;
+    }
+
+    const CpuFeatures& cpuFeatures()
+    {
+        static const CpuFeatures features = detectCpuFeatures();
+        return features;
+    }
+#endif
+
+    const DspKernels* findTable(SimdVariant variant)
+    {
+        if (variant == SimdDispatch::BASELINE)
+            return &DspKernelsBaseline::table;
+
+#if ABYSSVERB_HAVE_AVX2_KERNELS
+        if (variant == SimdVariant::avx2 && cpuFeatures().avx2)
+            return &DspKernelsAvx2::table;
+#endif
+#if ABYSSVERB_HAVE_AVX512_KERNELS
+        if (variant == SimdVariant::avx512 && cpuFeatures().avx512)
+            return &DspKernelsAvx512::table;
+#endif
+        return nullptr;
+    }
+
+    const DspKernels& selectOnce()
+    {
+        SimdVariant variant = SimdDispatch::detectBest();
+        if (const char* pinned = std::getenv(SimdDispatch::ENVIRONMENT_VARIABLE))
+        {
+            SimdVariant requested;
+            if (SimdDispatch::variantFromName(pinned, requested) && SimdDispatch::isAvailable(requested))
+                variant = requested;
+        }
+        return SimdDispatch::get(variant);
+    }
+}
+
+namespace SimdDispatch
+{
+    bool isAvailable(SimdVariant variant)
+    {
+        return findTable(variant) != nullptr;
+    }
+
+    SimdVariant detectBest()
+    {
+        for (auto variant : { SimdVariant::avx512, SimdVariant::avx2 })
+            if (isAvailable(variant))
+                return variant;
+        return BASELINE;
+    }
+
+    const DspKernels& get(SimdVariant variant)
+    {
+        const DspKernels* table = findTable(variant);
+        return table != nullptr ? *table : DspKernelsBaseline::table;
+    }
+
+    const DspKernels& baseline()
+    {
+        return DspKernelsBaseline::table;
+    }
+
+    const DspKernels& select()
+    {
+        static const DspKernels& selected = selectOnce();
+        return selected;
+    }
+
+    const char* variantName(SimdVariant variant)
+    {
+        static constexpr const char* names[] = { "scalar", "sse2", "neon", "avx2", "avx512" };
+        return names[static_cast<int>(variant)];
+    }
+
+    bool variantFromName(const char* name, SimdVariant& variant)
+    {
+        for (int i = 0; i <= static_cast<int>(SimdVariant::avx512); ++i)
+            if (std::strcmp(name, variantName(static_cast<SimdVariant>(i))) == 0)
+            {
+                variant = static_cast<SimdVariant>(i);
+                return true;
+            }
+        return false;
+    }
+}
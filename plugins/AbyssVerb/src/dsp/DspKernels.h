@@ -0,0 +1,115 @@
+#pragma once
+#include "DspCommon.h"
+#include "FractionalDelay.h"
+
+//==============================================================================
+// 命令セット別の DSP カーネル
+// 重いループ（FDN のライン更新、バイクアッド直列、出力段）は DspKernelBodies.h に一度だけ書き、
+// 命令セットごとの翻訳単位で別々にコンパイルする（ベースライン = SSE2 / NEON、AVX2、AVX-512）。
+// どれを使うかは prepare の時に CPUID で決め、各段は選ばれた表の関数ポインターを呼ぶ。
+// どの版も FMA 縮約なしでレーンごとに同じ演算をするので、出力はビット単位で一致する
+//==============================================================================
+enum class SimdVariant : int
+{
+    scalar,
+    sse2,
+    neon,
+    avx2,
+    avx512
+};
+
+struct DspKernels
+{
+    // FDN のライン数の上限（AbyssFDN は 4〜32 本）
+    static constexpr int MAX_LINES = 32;
+
+    // FDN のレーン単位の状態（AbyssFDN のメンバーを指す。配列は16バイト境界）
+    struct FdnLines
+    {
+        int numLines;                       // 4 の倍数
+        float* gainLo;
+        float* gainHi;
+        float* shelfState;
+        float* dampHi;
+        float* dampLo;
+        float feedbackScale;                // Hadamard の正規化 1/√numLines（÷ ダンパーの最大ゲイン）
+        bool shelfActive;
+        float shelfCoeff, dampingHigh, dampingLow;
+        const float* sincCoefficients;      // FractionalDelay::Sinc::table()（ポリフェーズのみ）
+    };
+
+    // バイクアッド1段（係数 [b0, b1, b2] / [1, a1, a2] と転置直接II型の状態）
+    struct BiquadSection
+    {
+        const float* b;
+        const float* a;
+        float* z1;
+        float* z2;
+    };
+
+    static constexpr int MAX_BIQUAD_SECTIONS = 4;
+
+    // ブロック内のゲイン: ランプ中はサンプルごとの値（ramp）、静止中は定数（value、ramp == nullptr）
+    struct Gain
+    {
+        const float* ramp;
+        float value;
+    };
+
+    SimdVariant variant;
+
+    // FDN の1サンプル: 補間読み出し → Hadamard フィードバック → RT60ゲインと2バンドダンピング。
+    // taps[l] はライン l の補間の先頭、frac / injection / outputs / processed は16バイト境界。
+    // outputs に補間した出力、processed にディレイへ書き戻す値を置く（添字は補間品質）
+    void (*fdnTick[FractionalDelay::NUM_QUALITIES])(const FdnLines& lines, const float* const* taps,
+                                                    const float* frac, const float* injection,
+                                                    float* outputs, float* processed);
+
+    // バイクアッドの直列（numSections <= MAX_BIQUAD_SECTIONS、in == out 可）。
+    // サンプル間の再帰で広いレジスタを活かせないので、どの版もベースラインの実装を指す
+    void (*biquadCascade)(const float* input, float* output, int numSamples,
+                          const BiquadSection* sections, int numSections);
+
+    // 出力段: wet = wet * reverbMix + delay * delayMix / out = dry * (1 - mix) + wet * mix /
+    // ソフトリミッター（アライメント不要）
+    void (*wetSum)(float* wet, const float* delay, Gain reverbMix, Gain delayMix, int numSamples);
+    void (*mix)(const float* dry, const float* wet, float* out, Gain mixAmount, int numSamples);
+    void (*softClip)(float* data, int numSamples);
+};
+
+//==============================================================================
+// カーネルの選択
+//==============================================================================
+namespace SimdDispatch
+{
+    // 設定すると選択を固定する（ベンチマーク用: scalar / sse2 / neon / avx2 / avx512）。
+    // この CPU で使えない・ビルドに含まれない版を指定したら自動選択に戻る
+    static constexpr const char* ENVIRONMENT_VARIABLE = "ABYSSVERB_SIMD";
+
+    // 常に使える版（SimdFloat4 の実装そのもの）
+#if ABYSSVERB_SIMD_SSE
+    static constexpr SimdVariant BASELINE = SimdVariant::sse2;
+#elif ABYSSVERB_SIMD_NEON
+    static constexpr SimdVariant BASELINE = SimdVariant::neon;
+#else
+    static constexpr SimdVariant BASELINE = SimdVariant::scalar;
+#endif
+
+    // ビルドに含まれていて、この CPU（と OS のレジスタ退避）で動く版か
+    bool isAvailable(SimdVariant variant);
+
+    // 使える版のうち最速のもの（環境変数は見ない）
+    SimdVariant detectBest();
+
+    // variant の表（使えなければベースライン）
+    const DspKernels& get(SimdVariant variant);
+
+    const DspKernels& baseline();
+
+    // 環境変数の指定、なければ detectBest の表。初回の呼び出しで決め、以後は同じ表を返す
+    // （prepare から呼ぶ。2回目以降は確保も CPUID もない）
+    const DspKernels& select();
+
+    const char* variantName(SimdVariant variant);
+    bool variantFromName(const char* name, SimdVariant& variant);
+}
@@ -0,0 +1,19 @@
+//==============================================================================
+// AVX2 版カーネル — この翻訳単位だけを -mavx2 -ffp-contract=off（/arch:AVX2）でコンパイルする。
+// FMA は使わない（縮約するとベースライン版と出力が一致しなくなる）
+//==============================================================================
+#include "SimdFloat8.h"
+#include "DspKernels.h"
+
+namespace DspKernelsAvx2
+{
+    using WideFloat = SimdFloat8;
+    using MediumFloat = SimdFloat8;
+    constexpr SimdVariant VARIANT = SimdVariant::avx2;
+}
+
+#define ABYSSVERB_KERNEL_NAMESPACE DspKernelsAvx2
+#define ABYSSVERB_KERNEL_SHARED_BIQUAD 1
+#include "DspKernelBodies.h"
+#undef ABYSSVERB_KERNEL_SHARED_BIQUAD
+#undef ABYSSVERB_KERNEL_NAMESPACE
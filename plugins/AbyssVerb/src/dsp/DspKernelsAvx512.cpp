@@ -0,0 +1,19 @@
+//==============================================================================
+// AVX-512 版カーネル — この翻訳単位だけを -mavx512f -ffp-contract=off（/arch:AVX512）でコンパイルする。
+// 出力段と16本以上の FDN は16レーン、8本の FDN は8レーン（AVX2 版と同じ命令）
+//==============================================================================
+#include "SimdFloat16.h"
+#include "DspKernels.h"
+
+namespace DspKernelsAvx512
+{
+    using WideFloat = SimdFloat16;
+    using MediumFloat = SimdFloat8;
+    constexpr SimdVariant VARIANT = SimdVariant::avx512;
+}
+
+#define ABYSSVERB_KERNEL_NAMESPACE DspKernelsAvx512
+#define ABYSSVERB_KERNEL_SHARED_BIQUAD 1
+#include "DspKernelBodies.h"
+#undef ABYSSVERB_KERNEL_SHARED_BIQUAD
+#undef ABYSSVERB_KERNEL_NAMESPACE
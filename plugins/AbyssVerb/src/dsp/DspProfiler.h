@@ -0,0 +1,353 @@
+#pragma once
+#include "SpscQueue.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define ABYSSVERB_PROFILE_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+ #include <x86intrin.h>
+ #define ABYSSVERB_PROFILE_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+ #define ABYSSVERB_PROFILE_CNTVCT 1
+#endif
+
+// CMake の ABYSSVERB_PROFILING で 1 にした時だけエンジンに計測が入る。
+// 0 なら ABYSSVERB_PROFILE_STAGE は何も生成せず、エンジンも計測用のメンバーを持たない
+#ifndef ABYSSVERB_PROFILING
+ #define ABYSSVERB_PROFILING 0
+#endif
+
+//==============================================================================
+// DSP 負荷の計測 — process 1回ごとに段別の経過ティックを数え、ロックなしのリングで
+// 非オーディオスレッド（エディターのメーター・レンダラー・ベンチマーク）へ渡す
+//==============================================================================
+
+// 計測するエンジンの段
+enum class ProfileStage { conditioner, envelope, delay, early, reverb, output };
+constexpr int NUM_PROFILE_STAGES = 6;
+
+inline const char* profileStageName(ProfileStage stage)
+{
+    static constexpr const char* names[] = { "conditioner", "envelope", "delay", "early", "reverb", "output" };
+    return names[static_cast<int>(stage)];
+}
+
+//==============================================================================
+// 計測用のクロック: x86 は TSC、AArch64 は仮想カウンター、それ以外は steady_clock（ns）
+//==============================================================================
+namespace ProfileClock
+{
+    inline std::uint64_t now() noexcept
+    {
+#if ABYSSVERB_PROFILE_TSC
+        return __rdtsc();
+#elif ABYSSVERB_PROFILE_CNTVCT
+        std::uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // 1秒あたりのティック数。TSC は初回の呼び出しで steady_clock に対して約20ms校正する
+    // （非オーディオスレッドから。エンジンの prepare が最初に呼ぶ）
+    inline double ticksPerSecond()
+    {
+        static const double rate = []
+        {
+#if ABYSSVERB_PROFILE_TSC
+            using Clock = std::chrono::steady_clock;
+            const auto wallStart = Clock::now();
+            const auto tickStart = now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const auto tickEnd = now();
+            const std::chrono::duration<double> wall = Clock::now() - wallStart;
+            return static_cast<double>(tickEnd - tickStart) / wall.count();
+#elif ABYSSVERB_PROFILE_CNTVCT
+            std::uint64_t frequency;
+            asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+            return static_cast<double>(frequency);
+#else
+            return 1.0e9;
+#endif
+        }();
+        return rate;
+    }
+}
+
+//==============================================================================
+// process 1回分の計測（ティック）。段の時間は L/R チェーンの合計なので、
+// 並列チャンネルモードでは段の和が totalTicks を超えることがある
+//==============================================================================
+struct ProfileFrame
+{
+    std::array<std::uint64_t, NUM_PROFILE_STAGES> stageTicks {};
+    std::uint64_t totalTicks = 0;   // process の入口から出口までの実時間
+    std::uint64_t budgetTicks = 0;  // ブロック長ぶんの実時間（これを超えるとこのインスタンスだけでドロップアウト）
+    int numSamples = 0;
+    bool sleeping = false;
+};
+
+//==============================================================================
+// 計測側（エンジンが持つ）— beginBlock / endBlock と段のスコープはオーディオスレッド
+// （R チェーンのワーカーはスロット 1 に書く）、pop は1つの非オーディオスレッドから
+//==============================================================================
+class DspProfiler
+{
+public:
+    static constexpr int QUEUE_SIZE = 512;  // 16サンプルのブロックでも 100ms ごとの読み出しで溢れない
+    static constexpr int NUM_SLOTS = 2;     // L/R チェーン（合流後の段はスロット 0）
+
+    void prepare(double sampleRate)
+    {
+        budgetTicksPerSample = ProfileClock::ticksPerSecond() / sampleRate;
+    }
+
+    void beginBlock() noexcept
+    {
+        for (auto& slot : slots)
+            slot.ticks.fill(0);
+        blockStart = ProfileClock::now();
+    }
+
+    void endBlock(int numSamples, bool sleeping) noexcept
+    {
+        ProfileFrame frame;
+        frame.totalTicks = ProfileClock::now() - blockStart;
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            frame.stageTicks[static_cast<size_t>(s)] = slots[0].ticks[static_cast<size_t>(s)]
+                                                     + slots[1].ticks[static_cast<size_t>(s)];
+        frame.budgetTicks = static_cast<std::uint64_t>(numSamples * budgetTicksPerSample);
+        frame.numSamples = numSamples;
+        frame.sleeping = sleeping;
+
+        if (! queue.push(frame))
+            dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 段の区間を計る（ABYSSVERB_PROFILE_STAGE が作る）
+    class Scope
+    {
+    public:
+        Scope(DspProfiler& owner, ProfileStage stageToTime, int slot) noexcept
+            : ticks(owner.slots[static_cast<size_t>(slot)].ticks[static_cast<size_t>(stageToTime)]),
+              start(ProfileClock::now()) {}
+        ~Scope() { ticks += ProfileClock::now() - start; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::uint64_t& ticks;
+        std::uint64_t start;
+    };
+
+    // 読み出し側
+    bool pop(ProfileFrame& frame) { return queue.pop(frame); }
+    long long getDroppedFrames() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    // スロットごとに別のキャッシュライン（並列モードで L/R が同時に書く）
+    struct alignas(64) SlotTicks
+    {
+        std::array<std::uint64_t, NUM_PROFILE_STAGES> ticks {};
+    };
+
+    std::array<SlotTicks, NUM_SLOTS> slots {};
+    std::uint64_t blockStart = 0;
+    double budgetTicksPerSample = 0.0;
+
+    SpscQueue<ProfileFrame, QUEUE_SIZE> queue;
+    std::atomic<long long> dropped { 0 };
+};
+
+#if ABYSSVERB_PROFILING
+ #define ABYSSVERB_PROFILE_STAGE(profiler, stage, slot) const DspProfiler::Scope profileScope { (profiler), (stage), (slot) }
+#else
+ #define ABYSSVERB_PROFILE_STAGE(profiler, stage, slot) static_cast<void>(0)
+#endif
+
+//==============================================================================
+// 計測フレームの集計（非オーディオスレッド）— 直近 WINDOW ブロックの負荷の平均・p99・最大と、
+// reset 以降の段別の累積 ns/sample。負荷はブロック長の実時間に対する割合（1 で実時間いっぱい）
+//==============================================================================
+class ProfileStatistics
+{
+public:
+    static constexpr int WINDOW = 512;
+
+    // p99 の負荷がこれ以上なら、ホストの他の処理と合わせてドロップアウトの危険がある
+    // （このインスタンスだけでコールバックの半分を使っている）
+    static constexpr double NEAR_DEADLINE_LOAD = 0.5;
+
+    struct Series
+    {
+        double mean = 0.0, p99 = 0.0, max = 0.0;
+    };
+
+    struct Summary
+    {
+        Series total;
+        std::array<Series, NUM_PROFILE_STAGES> stages {};
+        double nsPerSample = 0.0;                                   // reset 以降の累積
+        std::array<double, NUM_PROFILE_STAGES> stageNsPerSample {};
+        long long blocks = 0;       // reset 以降に集計したブロック数
+        long long overruns = 0;     // そのうち負荷が 1 以上だったブロック数
+        int windowBlocks = 0;
+        bool nearDeadline = false;  // 直近の窓で p99 >= NEAR_DEADLINE_LOAD
+        bool overrun = false;       // 直近の窓に負荷 1 以上のブロックがある
+        bool sleeping = false;      // 最後のブロックがスリープ中だったか
+    };
+
+    ProfileStatistics() : history(static_cast<size_t>(WINDOW)) {}
+
+    void reset()
+    {
+        next = count = 0;
+        totalTicks = 0;
+        stageTicks.fill(0);
+        samples = blocks = overruns = 0;
+        lastSleeping = false;
+    }
+
+    void add(const ProfileFrame& frame)
+    {
+        if (frame.numSamples <= 0 || frame.budgetTicks == 0)
+            return;
+
+        const double budget = static_cast<double>(frame.budgetTicks);
+        auto& entry = history[static_cast<size_t>(next)];
+        entry[0] = static_cast<double>(frame.totalTicks) / budget;
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            entry[static_cast<size_t>(s + 1)] = static_cast<double>(frame.stageTicks[static_cast<size_t>(s)]) / budget;
+        next = (next + 1) % WINDOW;
+        count = std::min(count + 1, WINDOW);
+
+        totalTicks += frame.totalTicks;
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            stageTicks[static_cast<size_t>(s)] += frame.stageTicks[static_cast<size_t>(s)];
+        samples += frame.numSamples;
+        ++blocks;
+        if (entry[0] >= 1.0)
+            ++overruns;
+        lastSleeping = frame.sleeping;
+    }
+
+    Summary summarize() const
+    {
+        Summary summary;
+        summary.blocks = blocks;
+        summary.overruns = overruns;
+        summary.windowBlocks = count;
+        summary.sleeping = lastSleeping;
+        if (count == 0)
+            return summary;
+
+        std::vector<double> values(static_cast<size_t>(count));
+        const auto series = [&](size_t column)
+        {
+            Series result;
+            for (int i = 0; i < count; ++i)
+            {
+                values[static_cast<size_t>(i)] = history[static_cast<size_t>(i)][column];
+                result.mean += values[static_cast<size_t>(i)];
+                result.max = std::max(result.max, values[static_cast<size_t>(i)]);
+            }
+            result.mean /= count;
+            const auto p99 = values.begin() + std::max(0, static_cast<int>(std::ceil(0.99 * count)) - 1);
+            std::nth_element(values.begin(), p99, values.end());
+            result.p99 = *p99;
+            return result;
+        };
+
+        summary.total = series(0);
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            summary.stages[static_cast<size_t>(s)] = series(static_cast<size_t>(s + 1));
+
+        const double nsPerTick = 1.0e9 / ProfileClock::ticksPerSecond();
+        const double perSample = nsPerTick / static_cast<double>(samples);
+        summary.nsPerSample = static_cast<double>(totalTicks) * perSample;
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            summary.stageNsPerSample[static_cast<size_t>(s)] = static_cast<double>(stageTicks[static_cast<size_t>(s)]) * perSample;
+
+        summary.nearDeadline = summary.total.p99 >= NEAR_DEADLINE_LOAD;
+        summary.overrun = summary.total.max >= 1.0;
+        return summary;
+    }
+
+    //==========================================================================
+    // ダンプ（ログ・レンダラー・ベンチマーク用）。時間はマイクロ秒、負荷はブロック長に対する割合
+    //==========================================================================
+    static std::string csvHeader()
+    {
+        std::string header = "block,samples,sleeping,total_us";
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+            header += std::string(",") + profileStageName(static_cast<ProfileStage>(s)) + "_us";
+        return header + ",load\n";
+    }
+
+    static std::string csvRow(long long block, const ProfileFrame& frame)
+    {
+        const double usPerTick = 1.0e6 / ProfileClock::ticksPerSecond();
+        char text[64];
+        std::snprintf(text, sizeof(text), "%lld,%d,%d,%.3f", block, frame.numSamples, frame.sleeping ? 1 : 0,
+                      static_cast<double>(frame.totalTicks) * usPerTick);
+        std::string row = text;
+        for (auto ticks : frame.stageTicks)
+        {
+            std::snprintf(text, sizeof(text), ",%.3f", static_cast<double>(ticks) * usPerTick);
+            row += text;
+        }
+        std::snprintf(text, sizeof(text), ",%.5f\n", frame.budgetTicks > 0
+                          ? static_cast<double>(frame.totalTicks) / static_cast<double>(frame.budgetTicks) : 0.0);
+        return row + text;
+    }
+
+    static std::string toJson(const Summary& summary)
+    {
+        const auto series = [](const Series& s)
+        {
+            char values[96];
+            std::snprintf(values, sizeof(values), "\"mean\": %.5f, \"p99\": %.5f, \"max\": %.5f", s.mean, s.p99, s.max);
+            return std::string(values);
+        };
+
+        char text[192];
+
+        std::snprintf(text, sizeof(text), "{\"blocks\": %lld, \"overruns\": %lld, \"near_deadline\": %s, "
+                                          "\"ns_per_sample\": %.3f, \"load\": {",
+                      summary.blocks, summary.overruns, summary.nearDeadline ? "true" : "false", summary.nsPerSample);
+        std::string json = text + series(summary.total) + "}, \"stages\": {";
+
+        for (int s = 0; s < NUM_PROFILE_STAGES; ++s)
+        {
+            std::snprintf(text, sizeof(text), "%s\"%s\": {\"ns_per_sample\": %.3f, ", s > 0 ? ", " : "",
+                          profileStageName(static_cast<ProfileStage>(s)), summary.stageNsPerSample[static_cast<size_t>(s)]);
+            json += text + series(summary.stages[static_cast<size_t>(s)]) + "}";
+        }
+        return json + "}}";
+    }
+
+private:
+    using Entry = std::array<double, NUM_PROFILE_STAGES + 1>; // [0] が process 全体、[1..] が段ごとの負荷
+
+    std::vector<Entry> history;
+    int next = 0, count = 0;
+
+    std::uint64_t totalTicks = 0;
+    std::array<std::uint64_t, NUM_PROFILE_STAGES> stageTicks {};
+    long long samples = 0, blocks = 0, overruns = 0;
+    bool lastSleeping = false;
+};
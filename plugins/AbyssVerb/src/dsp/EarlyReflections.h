@@ -0,0 +1,273 @@
+#pragma once
+#include "DspCommon.h"
+#include "PartitionedConvolver.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//==============================================================================
+// 初期反射用のインパルス応答（読み込んだままの形。1チャンネルならL/R共通）
+//==============================================================================
+struct ImpulseResponse
+{
+    double sampleRate = 0.0;
+    std::vector<std::vector<float>> channels;
+
+    bool isEmpty() const { return channels.empty() || channels[0].empty(); }
+};
+
+//==============================================================================
+// 初期反射 — 胴鳴り・部屋の短い IR をレイテンシなしの分割畳み込みで鳴らす段
+//
+// IR のリサンプル・正規化・分割FFTは setImpulseResponse を呼んだスレッドで行い、
+// 完成した係数をロックなしでオーディオスレッドへ渡す。オーディオスレッドは出力を
+// 短くフェードアウトさせ、無音になったブロック境界で差し替えてからフェードインする。
+// 差し替えで外れた係数は retired に置き、次の非オーディオスレッド呼び出しで解放する
+//==============================================================================
+class EarlyReflections
+{
+public:
+    static constexpr double MAX_LENGTH_SECONDS = 1.0; // 長い IR は切り詰める（後部残響は FDN が担う）
+    static constexpr double FADE_SECONDS = 0.01;
+
+    EarlyReflections() = default;
+    ~EarlyReflections()
+    {
+        delete pending.exchange(nullptr);
+        delete retired.exchange(nullptr);
+        delete current;
+    }
+
+    EarlyReflections(const EarlyReflections&) = delete;
+    EarlyReflections& operator=(const EarlyReflections&) = delete;
+
+    // 全バッファを確保し、設定済みの IR をこのサンプルレートで作り直す（オーディオスレッド停止中に）。
+    // FDL はこれまでで最も高いレート（か MAX_PREPARED_SAMPLE_RATE）での IR 長で確保し、長さが足りない時だけ確保し直す。
+    // レートが同じなら IR と畳み込みの状態はそのまま残す
+    void prepare(double sampleRate, int maxBlockSize)
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+        const bool rateChanged = maxLength == 0 || sampleRate != sr;
+        sr = sampleRate;
+        maxLength = static_cast<int>(std::ceil(sampleRate * MAX_LENGTH_SECONDS));
+
+        const int capacity = static_cast<int>(std::ceil(std::max(sampleRate, MAX_PREPARED_SAMPLE_RATE) * MAX_LENGTH_SECONDS));
+        if (capacity > preparedLength)
+        {
+            preparedLength = capacity;
+            for (auto& convolver : convolvers)
+                convolver.prepare(preparedLength);
+        }
+        if (gainBuffer.size() < static_cast<size_t>(std::max(1, maxBlockSize)))
+            gainBuffer.assign(static_cast<size_t>(std::max(1, maxBlockSize)), 0.0f);
+
+        if (! rateChanged)
+            return;
+
+        delete pending.exchange(nullptr);
+        delete retired.exchange(nullptr);
+        delete current;
+        current = source.isEmpty() ? nullptr : build(source).release();
+
+        gain = targetGain = isActive() ? 1.0f : 0.0f;
+        gainStep = 1.0f / static_cast<float>(sampleRate * FADE_SECONDS);
+        clear();
+    }
+
+    // IR を差し替える（非オーディオスレッドから。空の IR で解除）。係数はこのスレッドで作り、
+    // オーディオスレッドが次のブロックから受け取る。prepare 前なら保存だけして prepare で作る
+    void setImpulseResponse(ImpulseResponse impulseResponse)
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+        source = std::move(impulseResponse);
+        lengthSeconds.store(source.isEmpty() || source.sampleRate <= 0.0
+                                ? 0.0
+                                : std::min(static_cast<double>(source.channels[0].size()) / source.sampleRate, MAX_LENGTH_SECONDS),
+                            std::memory_order_relaxed);
+        if (maxLength == 0)
+            return;
+
+        // 受け取られなかった前の係数は一度もオーディオスレッドに渡っていないのでそのまま捨てる
+        delete pending.exchange(build(source).release(), std::memory_order_acq_rel);
+        delete retired.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    bool hasImpulseResponse() const
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+        return ! source.isEmpty();
+    }
+
+    void clear()
+    {
+        for (auto& convolver : convolvers)
+            convolver.clear();
+    }
+
+    // ブロック先頭（両チャンネルの process より前に1スレッドから）: 差し替えとフェードを進める
+    void beginBlock(int numSamples)
+    {
+        if (pending.load(std::memory_order_acquire) != nullptr
+            && retired.load(std::memory_order_acquire) == nullptr)
+        {
+            if (gain <= 0.0f || ! isActive())
+            {
+                const bool wasActive = isActive();
+                retired.store(current, std::memory_order_release);
+                current = pending.exchange(nullptr, std::memory_order_acq_rel);
+                if (! wasActive)
+                    clear(); // 止まっていた間の入力履歴は古い
+                targetGain = 1.0f;
+            }
+            else
+                targetGain = 0.0f;
+        }
+
+        fading = gain != targetGain;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            gainBuffer[static_cast<size_t>(i)] = gain;
+            gain = targetGain > gain ? std::min(gain + gainStep, targetGain) : std::max(gain - gainStep, targetGain);
+        }
+    }
+
+    // IR が設定されていて鳴らす必要があるか（false の間は process を呼ばなくてよい）
+    bool isActive() const { return current != nullptr && ! current->empty(); }
+
+    // 鳴らしている IR の長さ（オーディオスレッドから）。入力が止まってからこの長さで出力が尽きる
+    int getTailSamples() const
+    {
+        int length = 0;
+        if (current != nullptr)
+            for (const auto& kernel : *current)
+                length = std::max(length, kernel.getLength());
+        return length;
+    }
+
+    // 設定済みの IR の長さ [s]（切り詰め後の長さ）。ホストの getTailLengthSeconds から呼ばれるので、
+    // build 中の sourceLock を待たずに setImpulseResponse が残した値を読む（どのスレッドからでも）
+    double getLengthSeconds() const { return lengthSeconds.load(std::memory_order_relaxed); }
+
+    // 1チャンネルの畳み込み（チャンネルごとに別スレッドから呼んでよい）。in == out 可
+    void process(int channel, const float* input, float* output, int numSamples)
+    {
+        const auto& kernels = *current;
+        const auto& kernel = kernels[std::min(static_cast<size_t>(channel), kernels.size() - 1)];
+        convolvers[channel != 0 ? 1 : 0].process(kernel, input, output, numSamples);
+
+        if (fading)
+            for (int i = 0; i < numSamples; ++i)
+                output[i] *= gainBuffer[static_cast<size_t>(i)];
+    }
+
+private:
+    using KernelSet = std::vector<ConvolutionKernel>;
+
+    // リサンプル → 長さの制限 → エネルギー正規化（チャンネル共通のゲインで左右のバランスを保つ）→ 分割
+    std::unique_ptr<KernelSet> build(const ImpulseResponse& impulseResponse) const
+    {
+        auto kernels = std::make_unique<KernelSet>();
+        if (impulseResponse.isEmpty())
+            return kernels;
+
+        const int numChannels = std::min(2, static_cast<int>(impulseResponse.channels.size()));
+        std::vector<std::vector<float>> impulses;
+        double energy = 0.0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            impulses.push_back(resample(impulseResponse.channels[static_cast<size_t>(ch)],
+                                        impulseResponse.sampleRate, sr, maxLength));
+            for (float h : impulses.back())
+                energy += static_cast<double>(h) * h;
+        }
+
+        const float normalise = energy > 0.0 ? static_cast<float>(1.0 / std::sqrt(energy / numChannels)) : 0.0f;
+        for (auto& impulse : impulses)
+        {
+            for (auto& h : impulse)
+                h *= normalise;
+            kernels->emplace_back(impulse.data(), static_cast<int>(impulse.size()));
+        }
+        return kernels;
+    }
+
+    // カイザー窓付きsincによる帯域制限リサンプル（ダウンサンプル時は遮断周波数も下げる）。
+    // maxLength を超える分は切り捨て、切り口の 5ms をフェードアウトする
+    static std::vector<float> resample(const std::vector<float>& input, double fromRate, double toRate, int maxLength)
+    {
+        const double ratio = fromRate > 0.0 ? toRate / fromRate : 1.0;
+        const int fullLength = static_cast<int>(std::ceil(static_cast<double>(input.size()) * ratio));
+        std::vector<float> output(static_cast<size_t>(std::min(fullLength, maxLength)));
+
+        if (ratio == 1.0)
+            std::copy(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(output.size()), output.begin());
+        else
+        {
+            constexpr double pi = DspConstants<double>::pi;
+            constexpr double beta = 8.0;
+            const double cutoff = std::min(1.0, ratio);
+            const int halfWidth = static_cast<int>(std::ceil(16.0 / cutoff));
+            const int inputLength = static_cast<int>(input.size());
+
+            // 窓は |d| / halfWidth の表を線形補間で引く（タップごとに I0 を計算しない）
+            constexpr int windowPoints = 4096;
+            std::vector<double> window(windowPoints + 2, 0.0);
+            for (int i = 0; i <= windowPoints; ++i)
+            {
+                const double r = static_cast<double>(i) / windowPoints;
+                window[static_cast<size_t>(i)] = besselI0(beta * std::sqrt(1.0 - r * r)) / besselI0(beta);
+            }
+
+            for (size_t n = 0; n < output.size(); ++n)
+            {
+                const double position = static_cast<double>(n) / ratio;
+                const int centre = static_cast<int>(position);
+                double sum = 0.0;
+                for (int k = std::max(0, centre - halfWidth + 1); k <= std::min(inputLength - 1, centre + halfWidth); ++k)
+                {
+                    const double d = position - k;
+                    const double r = std::abs(d) / halfWidth * windowPoints;
+                    if (r >= windowPoints)
+                        continue;
+                    const int index = static_cast<int>(r);
+                    const double w = window[static_cast<size_t>(index)]
+                                   + (r - index) * (window[static_cast<size_t>(index) + 1] - window[static_cast<size_t>(index)]);
+                    const double x = pi * cutoff * d;
+                    const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+                    sum += input[static_cast<size_t>(k)] * cutoff * sinc * w;
+                }
+                output[n] = static_cast<float>(sum);
+            }
+        }
+
+        if (fullLength > maxLength)
+        {
+            const int fadeLength = std::min(maxLength, static_cast<int>(toRate * 0.005));
+            for (int i = 0; i < fadeLength; ++i)
+                output[output.size() - 1 - static_cast<size_t>(i)] *= static_cast<float>(i) / static_cast<float>(fadeLength);
+        }
+        return output;
+    }
+
+    // 非オーディオスレッド側（prepare / setImpulseResponse の直列化）
+    mutable std::mutex sourceLock;
+    ImpulseResponse source;
+    std::atomic<double> lengthSeconds { 0.0 }; // source の長さ（getLengthSeconds 用）
+    double sr = 48000.0;
+    int maxLength = 0;       // このレートで扱う IR の最大長
+    int preparedLength = 0;  // FDL を確保した IR 長
+
+    // スレッド間の受け渡し（pending: 非オーディオ → オーディオ、retired: オーディオ → 非オーディオ）
+    std::atomic<KernelSet*> pending { nullptr };
+    std::atomic<KernelSet*> retired { nullptr };
+
+    // オーディオスレッド側
+    KernelSet* current = nullptr;
+    PartitionedConvolver convolvers[2];
+    std::vector<float> gainBuffer;
+    float gain = 0.0f, targetGain = 0.0f, gainStep = 0.0f;
+    bool fading = false;
+};
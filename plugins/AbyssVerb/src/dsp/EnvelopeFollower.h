@@ -0,0 +1,46 @@
+#pragma once
+#include <cmath>
+
+//==============================================================================
+// エンベロープフォロワー — 弓の強さを追跡
+//==============================================================================
+class EnvelopeFollower
+{
+public:
+    void prepare(double sampleRate)
+    {
+        sr = sampleRate;
+        envelope = 0.0f;
+    }
+
+    void setParameters(float attackMs, float releaseMs)
+    {
+        attackCoeff  = std::exp(-1.0f / (static_cast<float>(sr) * attackMs  / 1000.0f));
+        releaseCoeff = std::exp(-1.0f / (static_cast<float>(sr) * releaseMs / 1000.0f));
+    }
+
+    float process(float input)
+    {
+        float rectified = std::abs(input);
+        if (rectified > envelope)
+            envelope = attackCoeff * envelope + (1.0f - attackCoeff) * rectified;
+        else
+            envelope = releaseCoeff * envelope + (1.0f - releaseCoeff) * rectified;
+        return envelope;
+    }
+
+    // ブロック処理（in == out 可）
+    void process(const float* input, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = process(input[i]);
+    }
+
+    float getEnvelope() const { return envelope; }
+
+private:
+    double sr = 48000.0;
+    float envelope = 0.0f;
+    float attackCoeff = 0.0f;
+    float releaseCoeff = 0.0f;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+//==============================================================================
+// 軽量乱数 (xorshift32) — オーディオスレッドで使える確保なし・分布オブジェクトなしの乱数
+// 同じシードからは常に同じ系列になる（QA用の決定的レンダリングの前提）
+//==============================================================================
+class FastRandom
+{
+public:
+    FastRandom() = default;
+    explicit FastRandom(std::uint32_t seedValue) { seed(seedValue); }
+
+    // 0 や連番のシードでも系列が偏らないよう、splitmix32 で状態を作る
+    void seed(std::uint32_t seedValue) noexcept
+    {
+        std::uint32_t z = seedValue + 0x9e3779b9u;
+        z = (z ^ (z >> 16)) * 0x85ebca6bu;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+        z ^= z >> 16;
+        state = z != 0 ? z : 0x6d2b79f5u; // xorshift の状態は 0 にしてはならない
+    }
+
+    std::uint32_t nextUInt() noexcept
+    {
+        std::uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state = x;
+        return x;
+    }
+
+    // [0, 1) の一様乱数（上位24ビットを使う）
+    float nextFloat() noexcept
+    {
+        return static_cast<float>(nextUInt() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // [minValue, maxValue] の一様整数（乗算による範囲縮小、偏りは 2^-32 程度）
+    int nextInt(int minValue, int maxValue) noexcept
+    {
+        const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(maxValue) - minValue + 1);
+        return minValue + static_cast<int>((static_cast<std::uint64_t>(nextUInt()) * range) >> 32);
+    }
+
+private:
+    std::uint32_t state = 0x6d2b79f5u;
+};
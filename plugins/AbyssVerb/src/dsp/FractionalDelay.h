@@ -0,0 +1,234 @@
+#pragma once
+#include "DspCommon.h"
+#include "SimdFloat4.h"
+#include "DelayMemoryArena.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+//==============================================================================
+// 分数遅延の補間品質（セッションごとに選ぶ CPU と音質のトレードオフ）
+//==============================================================================
+enum class InterpolationQuality : int
+{
+    linear,     // 2点線形。最も軽いが高域が鈍る
+    hermite,    // 4点3次エルミート（従来の補間、既定）
+    lagrange,   // 6点5次ラグランジュ
+    sinc        // 8点窓付きsinc（ポリフェーズ表）。強い変調でも明るい倍音を保つ
+};
+
+//==============================================================================
+// 分数遅延の読み出し — FDN と消失ディレイが共有する補間カーネル
+// 各カーネルは位置 base + frac（0 <= frac <= 1、インデックスが大きいほど新しいサンプル）の値を
+// base - FIRST から始まる TAPS 個の連続サンプルから求める。
+// 読み出しはディレイメモリのガード領域で連続に読めるので、TAPS は GUARD + 1 以下
+//==============================================================================
+namespace FractionalDelay
+{
+    static constexpr int MAX_TAPS = 8;
+    static_assert(DelayMemoryArena::GUARD + 1 >= MAX_TAPS, "delay guard region too small for the widest kernel");
+
+    static constexpr int NUM_QUALITIES = static_cast<int>(InterpolationQuality::sinc) + 1;
+
+    // カーネルの係数（float か SIMD型の全レーン）。evaluate は ISA 別のカーネル
+    // （DspKernels*.cpp）からも SIMD 型で呼ばれるので、どちらも強制インラインにしておく
+    template <typename T>
+    ABYSSVERB_SIMD_INLINE T constant(float x)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return x;
+        else
+            return T::broadcast(x);
+    }
+
+    struct Linear
+    {
+        static constexpr int TAPS = 2, FIRST = 0;
+        static constexpr bool POLYPHASE = false;
+        static constexpr InterpolationQuality QUALITY = InterpolationQuality::linear;
+
+        template <typename T>
+        static ABYSSVERB_SIMD_INLINE T evaluate(const T* y, T frac) { return y[0] + frac * (y[1] - y[0]); }
+    };
+
+    struct Hermite
+    {
+        static constexpr int TAPS = 4, FIRST = 1;
+        static constexpr bool POLYPHASE = false;
+        static constexpr InterpolationQuality QUALITY = InterpolationQuality::hermite;
+
+        template <typename T>
+        static ABYSSVERB_SIMD_INLINE T evaluate(const T* y, T frac)
+        {
+            const T half = constant<T>(0.5f);
+            const T c1 = half * (y[2] - y[0]);
+            const T c2 = y[0] - constant<T>(2.5f) * y[1] + constant<T>(2.0f) * y[2] - half * y[3];
+            const T c3 = half * (y[3] - y[0]) + constant<T>(1.5f) * (y[1] - y[2]);
+            return ((c3 * frac + c2) * frac + c1) * frac + y[1];
+        }
+    };
+
+    // ノード -2..3 の5次ラグランジュ。重み L_k = Π(frac - x_j) / Π(x_k - x_j) を前後の部分積で求める
+    struct Lagrange
+    {
+        static constexpr int TAPS = 6, FIRST = 2;
+        static constexpr bool POLYPHASE = false;
+        static constexpr InterpolationQuality QUALITY = InterpolationQuality::lagrange;
+
+        template <typename T>
+        static ABYSSVERB_SIMD_INLINE T evaluate(const T* y, T frac)
+        {
+            static constexpr float inverseDenominator[TAPS] = {
+                -1.0f / 120.0f, 1.0f / 24.0f, -1.0f / 12.0f, 1.0f / 12.0f, -1.0f / 24.0f, 1.0f / 120.0f
+            };
+
+            T distance[TAPS], prefix[TAPS];
+            for (int k = 0; k < TAPS; ++k)
+                distance[k] = frac - constant<T>(static_cast<float>(k - FIRST));
+            prefix[0] = constant<T>(1.0f);
+            for (int k = 1; k < TAPS; ++k)
+                prefix[k] = prefix[k - 1] * distance[k - 1];
+
+            T result = constant<T>(0.0f);
+            T suffix = constant<T>(1.0f);
+            for (int k = TAPS - 1; k >= 0; --k)
+            {
+                result = result + y[k] * (prefix[k] * suffix * constant<T>(inverseDenominator[k]));
+                suffix = suffix * distance[k];
+            }
+            return result;
+        }
+    };
+
+    // 8点カイザー窓（β = 7）付きsinc。frac を PHASES 段に量子化して係数行を引き、
+    // 8点の積和を SIMD 2レジスタで行う。各行は直流ゲイン 1 に正規化。
+    // 48kHz で 10kHz までの誤差は約 -60dB（エルミートは 10kHz で約 -25dB）
+    struct Sinc
+    {
+        static constexpr int TAPS = 8, FIRST = 3;
+        static constexpr bool POLYPHASE = true;
+        static constexpr InterpolationQuality QUALITY = InterpolationQuality::sinc;
+        static constexpr int PHASES = 1024;
+
+        struct Table
+        {
+            alignas(16) float coefficients[(PHASES + 1) * TAPS];
+
+            Table()
+            {
+                constexpr double cutoff = 1.0;  // ナイキスト比（窓が遷移帯を作る）
+                constexpr double beta = 7.0;
+                constexpr double pi = DspConstants<double>::pi;
+                const double halfWidth = TAPS / 2;
+
+                for (int phase = 0; phase <= PHASES; ++phase)
+                {
+                    const double frac = static_cast<double>(phase) / PHASES;
+                    double row[TAPS], sum = 0.0;
+                    for (int k = 0; k < TAPS; ++k)
+                    {
+                        const double d = static_cast<double>(k - FIRST) - frac;
+                        const double x = pi * cutoff * d;
+                        const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+                        const double ratio = d / halfWidth;
+                        const double window = std::abs(ratio) < 1.0
+                            ? besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / besselI0(beta) : 0.0;
+                        row[k] = sinc * window;
+                        sum += row[k];
+                    }
+                    for (int k = 0; k < TAPS; ++k)
+                        coefficients[phase * TAPS + k] = static_cast<float>(row[k] / sum);
+                }
+            }
+        };
+
+        // 係数表は初回呼び出しで作る（オーディオスレッドで作らないよう prepare から先に呼ぶ）
+        static const Table& table()
+        {
+            static const Table instance;
+            return instance;
+        }
+
+        static float read(const float* x, float frac)
+        {
+            const int phase = std::min(std::max(static_cast<int>(frac * PHASES + 0.5f), 0), PHASES);
+            const float* h = table().coefficients + phase * TAPS;
+            return (SimdFloat4::loadUnaligned(x) * SimdFloat4::load(h)
+                  + SimdFloat4::loadUnaligned(x + 4) * SimdFloat4::load(h + 4)).sum();
+        }
+    };
+
+    // 1点の読み出し（x は base - FIRST から TAPS 個）
+    template <typename Kernel>
+    inline float read(const float* x, float frac)
+    {
+        if constexpr (Kernel::POLYPHASE)
+            return Kernel::read(x, frac);
+        else
+            return Kernel::evaluate(x, frac);
+    }
+
+    // N 本（SIMD幅の倍数）の読み出しをまとめて補間する。taps[l] は各読み出しの先頭（base - FIRST）、
+    // frac / out は16バイト境界。多項式カーネルは読み出しをレーンに並べて係数計算ごとSIMDで、
+    // ポリフェーズは1本ずつ8点積和をSIMDで行う（どちらも read と同じ演算順なので結果は一致する）
+    template <typename Kernel, int N>
+    inline void interpolateLanes(const float* const* taps, const float* frac, float* out)
+    {
+        using V = SimdFloat4;
+        static_assert(N % V::SIZE == 0, "lane count must be a multiple of the SIMD width");
+
+        if constexpr (Kernel::POLYPHASE)
+        {
+            for (int l = 0; l < N; ++l)
+                out[l] = Kernel::read(taps[l], frac[l]);
+        }
+        else
+        {
+            alignas(16) float gathered[Kernel::TAPS][N];
+            for (int l = 0; l < N; ++l)
+                for (int k = 0; k < Kernel::TAPS; ++k)
+                    gathered[k][l] = taps[l][k];
+
+            for (int i = 0; i < N; i += V::SIZE)
+            {
+                V y[Kernel::TAPS];
+                for (int k = 0; k < Kernel::TAPS; ++k)
+                    y[k] = V::load(gathered[k] + i);
+                Kernel::evaluate(y, V::load(frac + i)).store(out + i);
+            }
+        }
+    }
+
+    // quality に対応するカーネルで fn(kernel) を呼ぶ（分岐はブロック単位で1回）
+    template <typename Fn>
+    inline void dispatch(InterpolationQuality quality, Fn&& fn)
+    {
+        switch (quality)
+        {
+            case InterpolationQuality::linear:   fn(Linear {}); break;
+            case InterpolationQuality::lagrange: fn(Lagrange {}); break;
+            case InterpolationQuality::sinc:     fn(Sinc {}); break;
+            case InterpolationQuality::hermite:
+            default:                             fn(Hermite {}); break;
+        }
+    }
+
+    // 状態・コマンドラインでの名前
+    inline const char* qualityName(InterpolationQuality quality)
+    {
+        static constexpr const char* names[] = { "linear", "hermite", "lagrange", "sinc" };
+        return names[static_cast<int>(quality)];
+    }
+
+    inline bool qualityFromName(const char* name, InterpolationQuality& quality)
+    {
+        for (int i = 0; i < NUM_QUALITIES; ++i)
+            if (std::strcmp(name, qualityName(static_cast<InterpolationQuality>(i))) == 0)
+            {
+                quality = static_cast<InterpolationQuality>(i);
+                return true;
+            }
+        return false;
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include "AbyssVerbEngine.h"
+#include "DspCommon.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// ゴールデンケース — 組み込みのバイオリン風テスト信号を固定の設定でレンダーする
+// テスト（AbyssVerbTests の golden、コミット済みの参照と比較）とオフラインレンダラーの
+// --golden（WAV の参照と比較）の共通部分。JUCE に依存しない
+//==============================================================================
+constexpr double GOLDEN_SAMPLE_RATE = 48000.0;
+constexpr double GOLDEN_INPUT_SECONDS = 3.0;
+constexpr double GOLDEN_TAIL_SECONDS = 3.0;
+
+// 擦弦の倍音列（1/k で減衰するノコギリ波的なスペクトル、ナイキスト未満の倍音のみ）
+inline float goldenBowedTone(double phase, double frequency)
+{
+    constexpr double pi = DspConstants<double>::pi;
+    double sum = 0.0;
+    for (int k = 1; k <= 24 && frequency * k < GOLDEN_SAMPLE_RATE * 0.45; ++k)
+        sum += std::sin(2.0 * pi * phase * k) / k;
+    return static_cast<float>(sum * 0.5);
+}
+
+// ビブラート付きのレガートで音符を弾く。notes は { 開始秒, 長さ秒, 周波数 }
+inline void goldenBowedNotes(std::vector<float>& out, std::initializer_list<std::array<double, 3>> notes,
+                             double gain, double vibratoRate)
+{
+    constexpr double pi = DspConstants<double>::pi;
+    for (const auto& note : notes)
+    {
+        const auto start = static_cast<size_t>(note[0] * GOLDEN_SAMPLE_RATE);
+        const auto length = static_cast<size_t>(note[1] * GOLDEN_SAMPLE_RATE);
+        double phase = 0.0;
+        for (size_t i = 0; i < length && start + i < out.size(); ++i)
+        {
+            const double t = static_cast<double>(i) / GOLDEN_SAMPLE_RATE;
+            // 弓のアタック 80ms、弓圧のふくらみ、リリース 120ms
+            const double attack = std::min(1.0, t / 0.08);
+            const double release = std::min(1.0, (note[1] - t) / 0.12);
+            const double swell = 0.8 + 0.2 * std::sin(pi * t / note[1]);
+            const double vibrato = 1.0 + 0.003 * std::sin(2.0 * pi * vibratoRate * t) * std::min(1.0, t / 0.4);
+            phase += note[2] * vibrato / GOLDEN_SAMPLE_RATE;
+            out[start + i] += static_cast<float>(gain * attack * release * swell) * goldenBowedTone(phase, note[2]);
+        }
+    }
+}
+
+// ピチカート: 鋭い立ち上がりと指数減衰（高次倍音ほど速く減衰）。plucks は { 開始秒, 周波数 }
+inline void goldenPizzicato(std::vector<float>& out, std::initializer_list<std::array<double, 2>> plucks)
+{
+    constexpr double pi = DspConstants<double>::pi;
+    for (const auto& pluck : plucks)
+    {
+        const auto start = static_cast<size_t>(pluck[0] * GOLDEN_SAMPLE_RATE);
+        for (size_t i = 0; start + i < out.size() && i < static_cast<size_t>(GOLDEN_SAMPLE_RATE); ++i)
+        {
+            const double t = static_cast<double>(i) / GOLDEN_SAMPLE_RATE;
+            double sum = 0.0;
+            for (int k = 1; k <= 12; ++k)
+                sum += std::sin(2.0 * pi * pluck[1] * k * t) * std::exp(-t * (4.0 + 3.0 * k)) / (k * k);
+            out[start + i] += static_cast<float>(0.6 * sum * std::min(1.0, t / 0.001));
+        }
+    }
+}
+
+struct GoldenCase
+{
+    const char* name;
+    bool stereoInput;
+    std::function<void(std::vector<float>& left, std::vector<float>& right)> generate;
+    std::function<void(ParamSnapshot& params, double seconds)> automate; // ブロック先頭ごとに呼ぶ
+};
+
+inline std::vector<GoldenCase> goldenCases()
+{
+    return {
+        { "bowed-legato", false,
+          [](std::vector<float>& left, std::vector<float>&)
+          {
+              goldenBowedNotes(left, { { 0.0, 0.9, 440.0 }, { 0.85, 0.9, 493.88 }, { 1.7, 1.2, 659.26 } }, 0.35, 5.5);
+          },
+          [](ParamSnapshot&, double) {} },
+
+        { "pizzicato-vanish", false,
+          [](std::vector<float>& left, std::vector<float>&)
+          {
+              goldenPizzicato(left, { { 0.0, 392.0 }, { 0.4, 293.66 }, { 0.8, 440.0 }, { 1.2, 659.26 }, { 2.0, 196.0 } });
+          },
+          [](ParamSnapshot& params, double)
+          {
+              params[Param::vanishRate] = 0.7f;
+              params[Param::delayFeedback] = 0.75f;
+          } },
+
+        { "double-stops-true-stereo", true,
+          [](std::vector<float>& left, std::vector<float>& right)
+          {
+              goldenBowedNotes(left, { { 0.0, 2.6, 293.66 } }, 0.3, 5.0);
+              goldenBowedNotes(right, { { 0.0, 2.6, 440.0 } }, 0.3, 5.8);
+          },
+          [](ParamSnapshot& params, double)
+          {
+              params[Param::trueStereo] = 1.0f;
+              params[Param::reverbDecay] = 12.0f;
+          } },
+
+        // 途中でパラメーターを動かし、サンプル単位のランプとトゥルーステレオのクロスフェードを通す
+        { "automation", true,
+          [](std::vector<float>& left, std::vector<float>& right)
+          {
+              goldenBowedNotes(left, { { 0.0, 1.4, 523.25 }, { 1.5, 1.4, 392.0 } }, 0.3, 5.5);
+              goldenPizzicato(right, { { 0.2, 261.63 }, { 1.1, 329.63 }, { 2.2, 392.0 } });
+          },
+          [](ParamSnapshot& params, double seconds)
+          {
+              if (seconds >= 1.0)
+              {
+                  params[Param::delayTime] = 800.0f;
+                  params[Param::reverbModDepth] = 2.0f;
+                  params[Param::masterMix] = 0.8f;
+              }
+              if (seconds >= 2.0)
+                  params[Param::trueStereo] = 1.0f;
+              if (seconds >= 4.0)
+                  params[Param::trueStereo] = 0.0f;
+          } },
+    };
+}
+
+struct GoldenRender
+{
+    std::vector<float> left, right;
+};
+
+// 不揃いなブロック長で回し、ブロック分割に依存する不具合も拾う
+inline GoldenRender renderGoldenCase(const GoldenCase& goldenCase)
+{
+    const auto inputLength = static_cast<size_t>(GOLDEN_INPUT_SECONDS * GOLDEN_SAMPLE_RATE);
+    const auto totalLength = inputLength + static_cast<size_t>(GOLDEN_TAIL_SECONDS * GOLDEN_SAMPLE_RATE);
+
+    GoldenRender result { std::vector<float>(totalLength, 0.0f), std::vector<float>(totalLength, 0.0f) };
+    std::vector<float> inputLeft(inputLength, 0.0f), inputRight(inputLength, 0.0f);
+    goldenCase.generate(inputLeft, inputRight);
+    std::copy(inputLeft.begin(), inputLeft.end(), result.left.begin());
+    std::copy(inputRight.begin(), inputRight.end(), result.right.begin());
+
+    auto params = ParamSnapshot::defaults();
+    goldenCase.automate(params, 0.0);
+
+    auto engine = std::make_unique<AbyssVerbEngine>();
+    engine->setRandomSeeds(AbyssVerbEngine::DEFAULT_SEED_LEFT, AbyssVerbEngine::DEFAULT_SEED_RIGHT);
+    engine->prepare(GOLDEN_SAMPLE_RATE, 512, params);
+
+    static constexpr int blockSizes[] = { 512, 61, 1024, 7, 300, 2048 };
+    constexpr int numBlockSizes = static_cast<int>(sizeof(blockSizes) / sizeof(blockSizes[0]));
+    size_t pos = 0;
+    for (int k = 0; pos < totalLength; ++k)
+    {
+        const auto numSamples = std::min(static_cast<size_t>(blockSizes[k % numBlockSizes]), totalLength - pos);
+        goldenCase.automate(params, static_cast<double>(pos) / GOLDEN_SAMPLE_RATE);
+        float* left = result.left.data() + pos;
+        float* right = result.right.data() + pos;
+        engine->process(left, goldenCase.stereoInput ? right : nullptr, left, right, static_cast<int>(numSamples), params);
+        pos += numSamples;
+    }
+    return result;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "DspCommon.h"
+#include "SimdFloat4.h"
+#include <algorithm>
+
+//==============================================================================
+// 変調用LFOバンク — 複数の正弦波LFOをまとめて生成する
+// sin はコントロールレート（CONTROL_INTERVAL サンプルごと）にSIMD多項式で求め、
+// その間は線形補間する。位相はサンプル単位で正確に進める（三角波などに使える）
+// 状態は render の呼び出し単位に依存しないので、1サンプルずつ呼んでもブロックで呼んでも同じ値になる
+//==============================================================================
+template <int NumLfos>
+class LfoBank
+{
+public:
+    static constexpr int NUM_LFOS = NumLfos;
+    static_assert(NUM_LFOS > 0 && NUM_LFOS % SimdFloat4::SIZE == 0,
+                  "LfoBank size must be a multiple of the SIMD width");
+
+    // 補間区間。LFOは最大でも数Hzなので、区間内の補間誤差は振幅の 1e-4 未満
+    static constexpr int CONTROL_INTERVAL = 32;
+
+    // 位相（0〜1 の周期単位）を設定し、補間をやり直す
+    void reset(const float* initialPhases)
+    {
+        std::copy(initialPhases, initialPhases + NUM_LFOS, phase);
+        for (int i = 0; i < NUM_LFOS; i += SimdFloat4::SIZE)
+            sinTurns(SimdFloat4::load(phase + i)).store(value + i);
+        std::fill(step, step + NUM_LFOS, 0.0f);
+        countdown = 0;
+    }
+
+    // 1サンプルあたりの位相増分（周波数 / サンプルレート、0 以上 1 未満）
+    void setIncrement(int index, float cyclesPerSample) { increment[index] = cyclesPerSample; }
+    void setIncrement(float cyclesPerSample) { std::fill(increment, increment + NUM_LFOS, cyclesPerSample); }
+
+    // numSamples 分の sin(2π·位相) と位相をサンプル順（[サンプル][LFO]）に書き出す
+    // （sinOut / phaseOut は16バイト境界、phaseOut は nullptr 可）
+    void render(float* sinOut, float* phaseOut, int numSamples)
+    {
+        using V = SimdFloat4;
+        constexpr int W = V::SIZE;
+        const V one = V::broadcast(1.0f);
+
+        for (int s = 0; s < numSamples; ++s)
+        {
+            if (countdown <= 0)
+                updateControl();
+            --countdown;
+
+            for (int i = 0; i < NUM_LFOS; i += W)
+            {
+                V p = V::load(phase + i) + V::load(increment + i);
+                p = p - V::selectGE(p, one, one);
+                p.store(phase + i);
+
+                const V y = V::load(value + i) + V::load(step + i);
+                y.store(value + i);
+                y.store(sinOut + s * NUM_LFOS + i);
+                if (phaseOut != nullptr)
+                    p.store(phaseOut + s * NUM_LFOS + i);
+            }
+        }
+    }
+
+    // sin(2π·x) の多項式近似（x は周期単位、|x| < 2^22）。誤差 6e-8 程度
+    static SimdFloat4 sinTurns(SimdFloat4 x) noexcept
+    {
+        using V = SimdFloat4;
+        // [-0.5, 0.5) に畳み、sin(π - θ) = sin θ で [0, 0.25] に折り返す
+        const V r = x - V::floor(x + V::broadcast(0.5f));
+        const V a = V::abs(r);
+        const V t = V::min(a, V::broadcast(0.5f) - a);
+        const V z = t * t;
+
+        // sin(2πt) のテイラー展開（t^11 まで）
+        V poly = V::broadcast(-15.094642576822984f);
+        poly = poly * z + V::broadcast(42.058693944897634f);
+        poly = poly * z + V::broadcast(-76.70585975306136f);
+        poly = poly * z + V::broadcast(81.60524927607504f);
+        poly = poly * z + V::broadcast(-41.341702240399755f);
+        poly = poly * z + V::broadcast(6.283185307179586f);
+        return V::copySign(poly * t, r);
+    }
+
+private:
+    // 区間の終点（現在の増分で CONTROL_INTERVAL 進んだ位置）の sin を求め、そこへの傾きを決める。
+    // 区間の途中で増分が変わっても、次の区間で実際の位相に向けて補正される
+    void updateControl()
+    {
+        using V = SimdFloat4;
+        countdown = CONTROL_INTERVAL;
+
+        const V span = V::broadcast(static_cast<float>(CONTROL_INTERVAL));
+        const V inverseSpan = V::broadcast(1.0f / static_cast<float>(CONTROL_INTERVAL));
+        for (int i = 0; i < NUM_LFOS; i += V::SIZE)
+        {
+            const V target = sinTurns(V::load(phase + i) + V::load(increment + i) * span);
+            ((target - V::load(value + i)) * inverseSpan).store(step + i);
+        }
+    }
+
+    alignas(16) float phase[NUM_LFOS] = {};
+    alignas(16) float increment[NUM_LFOS] = {};
+    alignas(16) float value[NUM_LFOS] = {};
+    alignas(16) float step[NUM_LFOS] = {};
+    int countdown = 0;
+};
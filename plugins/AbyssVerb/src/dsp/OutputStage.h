@@ -0,0 +1,43 @@
+#pragma once
+#include "DspKernels.h"
+#include <cmath>
+#include <algorithm>
+
+//==============================================================================
+// 出力段 — ウェット合成・ソフトリミッター・ドライ/ウェットミックス
+// SIMD の本体は命令セット別のカーネル（DspKernels の wetSum / softClip / mix）にあり、
+// ここにはゲインの型と、リミッター曲線のスカラー参照実装を置く
+//==============================================================================
+struct OutputStage
+{
+    // ブロック内のゲイン: ランプ中はサンプルごとの値、静止中は定数
+    using Gain = DspKernels::Gain;
+
+    //==========================================================================
+    // ソフトリミッター: |x| <= K はそのまま、それより上は K + W (1 - e^-((|x|-K) / W)) で 1 に漸近する
+    // （K = SOFT_CLIP_KNEE, W = SOFT_CLIP_WIDTH = 1 - K。ニーで値も傾きも連続、出力は常に ±1 以内）。
+    // 分岐なしで
+    //   y = copysign(min(|x|, K) + W (1 - e^-(max(|x|-K, 0) / W)), x)
+    // と書けるので、SIMD版は指数関数だけを近似する。
+    // 近似精度（このスカラー版との比較、|x| <= 60 を 1e-4 刻みで走査）:
+    //   曲線の絶対誤差 最大 6e-8、出力の最大値はちょうど 1。
+    //   |x| <= K では近似が e^0 = 1 を厳密に返すので、入力がそのまま（ビット単位で）通る
+    // 出荷版の曲線（|x| <= 1 はそのまま、|x| > 1 は 1 - e^-(|x|-1)）との違い（SIMD版で同じ走査）:
+    //   |x| <= 0.9 は一致（ビット単位）。
+    //   0.9 < |x| <= 1 はこの曲線の方が低く、音が変わる: 0.95 で -0.10 dB、0.98 で -0.22 dB、
+    //   1 で最大 -0.33 dB（0.9632 対 1、絶対誤差 0.0368）。
+    //   |x| > 1 は出荷版が不連続（1 の直後で 0 に落ち、2 でも 0.63）だったのを直した区間で、
+    //   1.1 で +20 dB、2 で +4 dB、4 で +0.4 dB
+    //==========================================================================
+    static constexpr float SOFT_CLIP_KNEE = 0.9f;
+    static constexpr float SOFT_CLIP_WIDTH = 0.1f;
+
+    static float softClipReference(float x)
+    {
+        const float a = std::abs(x);
+        if (a <= SOFT_CLIP_KNEE)
+            return x;
+        const double over = (a - SOFT_CLIP_KNEE) / static_cast<double>(SOFT_CLIP_WIDTH);
+        return std::copysign(static_cast<float>(SOFT_CLIP_KNEE + SOFT_CLIP_WIDTH * (1.0 - std::exp(-over))), x);
+    }
+};
@@ -0,0 +1,80 @@
+#include "ParallelChainWorker.h"
+
+#if defined(_WIN32)
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#elif defined(__APPLE__)
+ #include <mach/mach.h>
+ #include <mach/mach_time.h>
+ #include <mach/thread_policy.h>
+ #include <pthread.h>
+#else
+ #include <pthread.h>
+ #include <sched.h>
+#endif
+
+#include <algorithm>
+
+//==============================================================================
+// スレッド優先度 — OS ごとの API はヘッダーに出さずここだけで使う
+//==============================================================================
+bool ParallelChainWorker::setPriority(Priority newPriority, double periodSeconds)
+{
+    if (! running.load(std::memory_order_acquire))
+        return false;
+
+    const bool realtime = newPriority == Priority::realtime;
+    bool applied = false;
+
+#if defined(_WIN32)
+    // Windows: 周期の指定はない。MMCSS のオーディオスレッドと同じ最上位のクラス内優先度
+    (void) periodSeconds;
+    applied = SetThreadPriority(static_cast<HANDLE>(thread.native_handle()),
+                                realtime ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_NORMAL) != 0;
+#elif defined(__APPLE__)
+    const auto machThread = pthread_mach_thread_np(thread.native_handle());
+    if (realtime)
+    {
+        // Core Audio の IO スレッドと同じ time constraint。周期はブロック長、
+        // 1周期の計算時間はその半分（L/R の片方ぶん）を上限に申告する
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        const double ticksPerSecond = 1.0e9 * timebase.denom / timebase.numer;
+        const auto period = static_cast<uint32_t>(std::max(periodSeconds, 1.0e-4) * ticksPerSecond);
+
+        thread_time_constraint_policy_data_t policy;
+        policy.period = period;
+        policy.computation = period / 2;
+        policy.constraint = period;
+        policy.preemptible = true;
+        applied = thread_policy_set(machThread, THREAD_TIME_CONSTRAINT_POLICY,
+                                    reinterpret_cast<thread_policy_t>(&policy),
+                                    THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+    }
+    else
+    {
+        thread_standard_policy_data_t policy {};
+        applied = thread_policy_set(machThread, THREAD_STANDARD_POLICY,
+                                    reinterpret_cast<thread_policy_t>(&policy),
+                                    THREAD_STANDARD_POLICY_COUNT) == KERN_SUCCESS;
+    }
+#else
+    // Linux ほか POSIX: SCHED_FIFO（RLIMIT_RTPRIO か CAP_SYS_NICE が要る）。
+    // オーディオスレッド（JACK / PipeWire は 80 前後）より少し下に置く
+    (void) periodSeconds;
+    sched_param param {};
+    int policy = SCHED_OTHER;
+    if (realtime)
+    {
+        policy = SCHED_FIFO;
+        param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO) - 30);
+    }
+    applied = pthread_setschedparam(thread.native_handle(), policy, &param) == 0;
+#endif
+
+    if (applied)
+        priority.store(newPriority, std::memory_order_relaxed);
+    return applied;
+}
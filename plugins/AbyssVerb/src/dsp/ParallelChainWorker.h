@@ -0,0 +1,202 @@
+#pragma once
+#include "DspCommon.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//==============================================================================
+// チャンネルチェーン用ワーカー — 事前に起動した1本のスレッドに1ジョブずつ渡す
+// オーディオスレッド側（submit / wait）はロックも確保もしない。
+// ワーカーがまだジョブを取っていなければ wait 側が自分で実行する（ワークスティール）ので、
+// ワーカーが待機から起きるのが遅れても、最悪でも直列処理と同じ時間で終わる。
+// 取った後のジョブは取り返せないので、オーディオスレッドから使うならワーカーを
+// Priority::realtime にする（プラグインはさらにホストのオーディオワークグループへ
+// スレッドフックで参加させる）。wait は期限を過ぎたら false を返し、呼び出し側は
+// しばらく直列に戻す
+//==============================================================================
+class ParallelChainWorker
+{
+public:
+    using JobFunction = void (*)(void* context);
+
+    enum class Priority { normal, realtime };
+
+    ParallelChainWorker() = default;
+    ~ParallelChainWorker() { stop(); }
+
+    ParallelChainWorker(const ParallelChainWorker&) = delete;
+    ParallelChainWorker& operator=(const ParallelChainWorker&) = delete;
+
+    // スレッドの起動・停止（非オーディオスレッドから呼ぶ）
+    void start()
+    {
+        if (running.load(std::memory_order_acquire))
+            return;
+
+        quit.store(false, std::memory_order_relaxed);
+        state.store(IDLE, std::memory_order_relaxed);
+        priority.store(Priority::normal, std::memory_order_relaxed);
+        hookRequested.store(threadHook != nullptr, std::memory_order_relaxed);
+        thread = std::thread([this] { run(); });
+        running.store(true, std::memory_order_release);
+    }
+
+    // 起動中のスレッドの優先度（非オーディオスレッドから）。realtime は periodSeconds ごとに
+    // 1ジョブを返す周期スレッドとして OS に登録する（macOS の time constraint、Linux の SCHED_FIFO、
+    // Windows の TIME_CRITICAL）。上げられなかったら（権限がないなど）false で、優先度は変わらない
+    bool setPriority(Priority priority, double periodSeconds);
+    Priority getPriority() const { return priority.load(std::memory_order_relaxed); }
+
+    // ワーカースレッド上で実行するフック（オーディオワークグループへの参加など。起動前に設定する）。
+    // 起動直後と requestThreadHook のたびに、ワーカーは次のジョブより前に1回だけ呼ぶ
+    void setThreadHook(JobFunction hook, void* context)
+    {
+        threadHook = hook;
+        hookContext = context;
+    }
+
+    void requestThreadHook()
+    {
+        if (threadHook == nullptr)
+            return;
+
+        hookRequested.store(true, std::memory_order_release);
+        if (sleeping.load(std::memory_order_acquire))
+            sleepCondition.notify_one();
+    }
+
+    void stop()
+    {
+        if (! running.load(std::memory_order_acquire))
+            return;
+
+        running.store(false, std::memory_order_release);
+        {
+            const std::lock_guard<std::mutex> lock(sleepMutex);
+            quit.store(true, std::memory_order_release);
+        }
+        sleepCondition.notify_one();
+        thread.join();
+    }
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    // ジョブを渡す（オーディオスレッド）。wait() までに次の submit をしてはならない
+    void submit(JobFunction function, void* context)
+    {
+        jobFunction = function;
+        jobContext = context;
+        state.store(READY, std::memory_order_release);
+
+        // 休眠中のときだけ起こす（通常はスピン中に拾われる）
+        if (sleeping.load(std::memory_order_acquire))
+            sleepCondition.notify_one();
+    }
+
+    // ジョブの完了を待つ（オーディオスレッド）。まだ取られていなければ自分で実行する。
+    // ワーカーが deadline までに終えなかったら false（完了までは待つ。次から直列に戻す合図）
+    bool wait(std::chrono::steady_clock::time_point deadline)
+    {
+        bool onTime = true;
+        if (! tryRunJob())
+            for (int spin = 0; state.load(std::memory_order_acquire) != DONE; ++spin)
+            {
+                cpuPause();
+                // 時刻は間引いて見る
+                if (onTime && (spin & (DEADLINE_CHECK_INTERVAL - 1)) == 0
+                    && std::chrono::steady_clock::now() > deadline)
+                    onTime = false;
+            }
+
+        state.store(IDLE, std::memory_order_relaxed);
+        return onTime;
+    }
+
+private:
+    enum : int { IDLE, READY, RUNNING, DONE };
+
+    // ジョブ直後はすぐ次が来るので短くスピン、来なければ少し yield してすぐ休眠する
+    // （休眠中に来たジョブは wait 側が自分で実行するので、起きるのが遅れても待たない）
+    static constexpr int SPIN_COUNT = 1 << 8;
+    static constexpr int YIELD_COUNT = 1 << 6;
+    static constexpr int DEADLINE_CHECK_INTERVAL = 1 << 4;
+
+    static void cpuPause()
+    {
+#if ABYSSVERB_SIMD_SSE
+        _mm_pause();
+#elif ABYSSVERB_SIMD_NEON && (defined(__GNUC__) || defined(__clang__))
+        asm volatile("yield");
+#endif
+    }
+
+    bool tryRunJob()
+    {
+        int expected = READY;
+        if (! state.compare_exchange_strong(expected, RUNNING, std::memory_order_acq_rel))
+            return false;
+
+        jobFunction(jobContext);
+        state.store(DONE, std::memory_order_release);
+        return true;
+    }
+
+    void run()
+    {
+        int idle = 0;
+        while (! quit.load(std::memory_order_acquire))
+        {
+            if (threadHook != nullptr && hookRequested.load(std::memory_order_acquire)
+                && hookRequested.exchange(false, std::memory_order_acq_rel))
+                threadHook(hookContext);
+
+            if (tryRunJob())
+            {
+                idle = 0;
+                continue;
+            }
+
+            if (idle < SPIN_COUNT)
+            {
+                ++idle;
+                cpuPause();
+            }
+            else if (idle < SPIN_COUNT + YIELD_COUNT)
+            {
+                ++idle;
+                std::this_thread::yield();
+            }
+            else
+            {
+                // 休眠。submit 側はロックを取らないので、起こし損ねても短いタイムアウトで拾う
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                sleeping.store(true, std::memory_order_release);
+                sleepCondition.wait_for(lock, std::chrono::milliseconds(1), [this]
+                {
+                    return quit.load(std::memory_order_acquire)
+                        || state.load(std::memory_order_acquire) == READY
+                        || hookRequested.load(std::memory_order_acquire);
+                });
+                sleeping.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    std::thread thread;
+    std::atomic<bool> running { false };
+    std::atomic<bool> quit { false };
+    std::atomic<bool> sleeping { false };
+    std::atomic<int> state { IDLE };
+    std::atomic<Priority> priority { Priority::normal };
+    std::atomic<bool> hookRequested { false };
+
+    JobFunction jobFunction = nullptr;
+    void* jobContext = nullptr;
+    JobFunction threadHook = nullptr;
+    void* hookContext = nullptr;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+};
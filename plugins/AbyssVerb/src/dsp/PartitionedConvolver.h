@@ -0,0 +1,253 @@
+#pragma once
+#include "DspCommon.h"
+#include "SimdFloat4.h"
+#include "RealFft.h"
+#include <algorithm>
+#include <new>
+#include <vector>
+
+// スペクトル・FDL は std::vector に置き、先頭を SIMD の load にそのまま渡す
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= 16, "vector storage must be 16-byte aligned for SimdFloat4::load");
+
+//==============================================================================
+// レイテンシなしの分割畳み込み
+// IR を先頭の直接型FIRと、ブロック長の違う2段の一様分割畳み込み（周波数領域ディレイライン +
+// オーバーラップセーブ）に分けて受け持つ。各段の結果はブロック長ぶん遅れて出るが、
+// 段が受け持つタップもちょうどその位置から始まるので、全体として遅延は増えない
+//   直接型 [0, 64)  短ブロック段 B = 64 [64, 1024)  長ブロック段 B = 1024 [1024, 長さ)
+// 長ブロック段の FFT と積和は 1024 サンプルに1回まとめて走る
+//==============================================================================
+namespace PartitionedConvolution
+{
+    static constexpr int HEAD_LENGTH = 64;
+    static constexpr int SHORT_BLOCK = 64;
+    static constexpr int LONG_BLOCK = 1024;
+
+    enum { SHORT_SEGMENT, LONG_SEGMENT, NUM_SEGMENTS };
+
+    // 段の受け持ち [blockSize, end)。blockSize 以降のタップなので段の遅延がちょうど吸収される
+    constexpr int segmentBlockSize(int segment) { return segment == SHORT_SEGMENT ? SHORT_BLOCK : LONG_BLOCK; }
+    constexpr int segmentEnd(int segment, int length) { return segment == SHORT_SEGMENT ? std::min(LONG_BLOCK, length) : length; }
+
+    static_assert(HEAD_LENGTH == SHORT_BLOCK && LONG_BLOCK % SHORT_BLOCK == 0, "segments must tile the impulse response");
+
+    inline int numPartitions(int segment, int length)
+    {
+        const int blockSize = segmentBlockSize(segment);
+        return std::max(0, (segmentEnd(segment, length) - blockSize + blockSize - 1) / blockSize);
+    }
+}
+
+//==============================================================================
+// 1チャンネルの IR の分割済み係数（不変。非オーディオスレッドで作る）
+//==============================================================================
+class ConvolutionKernel
+{
+public:
+    ConvolutionKernel(const float* impulse, int impulseLength)
+        : length(impulseLength)
+    {
+        using namespace PartitionedConvolution;
+
+        // 直接型は x[n-63..n] との内積にするため逆順で持つ
+        head.assign(HEAD_LENGTH, 0.0f);
+        for (int k = 0; k < std::min(HEAD_LENGTH, length); ++k)
+            head[static_cast<size_t>(HEAD_LENGTH - 1 - k)] = impulse[k];
+
+        for (int s = 0; s < NUM_SEGMENTS; ++s)
+        {
+            const int blockSize = segmentBlockSize(s);
+            const int end = segmentEnd(s, length);
+            auto& segment = segments[s];
+            segment.numPartitions = numPartitions(s, length);
+            segment.spectra.assign(static_cast<size_t>(segment.numPartitions * 2 * blockSize), 0.0f);
+
+            // 区画 p = h[B + pB, B + pB + B) を 2B に零詰めして変換。逆変換の 2B 倍をここで打ち消す
+            RealFft fft;
+            fft.setSize(2 * blockSize);
+            std::vector<float> frame(static_cast<size_t>(2 * blockSize));
+            const float scale = 1.0f / static_cast<float>(2 * blockSize);
+            for (int p = 0; p < segment.numPartitions; ++p)
+            {
+                std::fill(frame.begin(), frame.end(), 0.0f);
+                const int first = blockSize + p * blockSize;
+                for (int j = 0; j < blockSize && first + j < end; ++j)
+                    frame[static_cast<size_t>(j)] = impulse[first + j] * scale;
+
+                float* re = segment.spectra.data() + static_cast<size_t>(p * 2 * blockSize);
+                fft.forward(frame.data(), re, re + blockSize);
+            }
+        }
+    }
+
+    int getLength() const { return length; }
+
+private:
+    friend class PartitionedConvolver;
+
+    struct Segment
+    {
+        int numPartitions = 0;
+        std::vector<float> spectra; // 区画 p の実部が p·2B から B 個、虚部がその後に B 個
+    };
+
+    int length = 0;
+    std::vector<float> head;
+    Segment segments[PartitionedConvolution::NUM_SEGMENTS];
+};
+
+//==============================================================================
+// 1チャンネルの畳み込み状態（入力履歴・FDL・段の出力）。係数は process ごとに渡すので、
+// 同じ状態のまま別の IR に差し替えられる（FDL は入力のスペクトルだけを持つ）
+//==============================================================================
+class PartitionedConvolver
+{
+public:
+    // maxLength: 扱う IR の最大長。FDL はこの長さぶん確保する（確保はここだけ）
+    void prepare(int maxLength)
+    {
+        using namespace PartitionedConvolution;
+
+        for (int s = 0; s < NUM_SEGMENTS; ++s)
+        {
+            auto& segment = segments[s];
+            const int blockSize = segmentBlockSize(s);
+            segment.blockSize = blockSize;
+            segment.numSlots = std::max(1, numPartitions(s, maxLength));
+            segment.fft.setSize(2 * blockSize);
+            segment.input.assign(static_cast<size_t>(2 * blockSize), 0.0f);
+            segment.output.assign(static_cast<size_t>(blockSize), 0.0f);
+            segment.time.assign(static_cast<size_t>(2 * blockSize), 0.0f);
+            segment.accumulator.assign(static_cast<size_t>(2 * blockSize), 0.0f);
+            segment.fdl.assign(static_cast<size_t>(segment.numSlots * 2 * blockSize), 0.0f);
+        }
+        clear();
+    }
+
+    void clear()
+    {
+        for (auto& segment : segments)
+        {
+            std::fill(segment.input.begin(), segment.input.end(), 0.0f);
+            std::fill(segment.output.begin(), segment.output.end(), 0.0f);
+            std::fill(segment.fdl.begin(), segment.fdl.end(), 0.0f);
+            segment.slot = 0;
+            segment.position = 0;
+        }
+    }
+
+    // in == out 可
+    void process(const ConvolutionKernel& kernel, const float* input, float* output, int numSamples)
+    {
+        using namespace PartitionedConvolution;
+        using V = SimdFloat4;
+        auto& shortSegment = segments[SHORT_SEGMENT];
+        auto& longSegment = segments[LONG_SEGMENT];
+        const float* head = kernel.head.data();
+
+        while (numSamples > 0)
+        {
+            // 短ブロックの境界まで（長ブロックの境界は必ず短ブロックの境界に重なる）
+            const int len = std::min(numSamples, SHORT_BLOCK - shortSegment.position);
+            float* shortInput = shortSegment.input.data() + SHORT_BLOCK + shortSegment.position;
+            float* longInput = longSegment.input.data() + LONG_BLOCK + longSegment.position;
+            std::copy(input, input + len, shortInput);
+            std::copy(input, input + len, longInput);
+
+            // 直接型: 短ブロック段の入力フレーム [前ブロック | 今のブロック] がそのまま直前63サンプルの履歴になる
+            const float* shortOut = shortSegment.output.data() + shortSegment.position;
+            const float* longOut = longSegment.output.data() + longSegment.position;
+            for (int i = 0; i < len; ++i)
+            {
+                const float* x = shortInput + i - (HEAD_LENGTH - 1);
+                V sum = V::loadUnaligned(x) * V::load(head);
+                for (int k = V::SIZE; k < HEAD_LENGTH; k += V::SIZE)
+                    sum = sum + V::loadUnaligned(x + k) * V::load(head + k);
+                output[i] = sum.sum() + shortOut[i] + longOut[i];
+            }
+
+            shortSegment.position += len;
+            longSegment.position += len;
+            if (shortSegment.position == SHORT_BLOCK)
+                advance(shortSegment, kernel.segments[SHORT_SEGMENT]);
+            if (longSegment.position == LONG_BLOCK)
+                advance(longSegment, kernel.segments[LONG_SEGMENT]);
+
+            input += len;
+            output += len;
+            numSamples -= len;
+        }
+    }
+
+private:
+    struct Segment
+    {
+        int blockSize = 0;
+        int numSlots = 1;
+        int slot = 0;       // FDL の最新スロット
+        int position = 0;   // ブロック内の位置
+        RealFft fft;
+        std::vector<float> input;       // [前ブロック | 今のブロック]
+        std::vector<float> output;      // 次のブロックで鳴らす段の出力
+        std::vector<float> time;
+        std::vector<float> accumulator; // 実部 B 個 + 虚部 B 個
+        std::vector<float> fdl;         // 入力フレームのスペクトル × numSlots
+    };
+
+    // ブロック終端: 入力フレームを FDL に積み、係数の区画と掛け合わせて次のブロックの出力を作る
+    static void advance(Segment& segment, const ConvolutionKernel::Segment& spectra)
+    {
+        using V = SimdFloat4;
+        const int blockSize = segment.blockSize;
+        const int stride = 2 * blockSize;
+        segment.position = 0;
+
+        const int partitions = std::min(spectra.numPartitions, segment.numSlots);
+        if (partitions == 0)
+        {
+            // この IR はこの段まで届かない（FDL も使わないので変換を省く）
+            std::fill(segment.output.begin(), segment.output.end(), 0.0f);
+            std::copy(segment.input.begin() + blockSize, segment.input.end(), segment.input.begin());
+            return;
+        }
+
+        segment.slot = segment.slot + 1 < segment.numSlots ? segment.slot + 1 : 0;
+        float* newest = segment.fdl.data() + static_cast<size_t>(segment.slot * stride);
+        segment.fft.forward(segment.input.data(), newest, newest + blockSize);
+        std::copy(segment.input.begin() + blockSize, segment.input.end(), segment.input.begin());
+
+        // Σ X[今 - p]·H[p]。ビン 0 は直流とナイキストの実数2つなので SIMD の後で別に求める
+        float* accRe = segment.accumulator.data();
+        float* accIm = accRe + blockSize;
+        std::fill(segment.accumulator.begin(), segment.accumulator.end(), 0.0f);
+        float dc = 0.0f, nyquist = 0.0f;
+        int slot = segment.slot;
+        for (int p = 0; p < partitions; ++p)
+        {
+            const float* xRe = segment.fdl.data() + static_cast<size_t>(slot * stride);
+            const float* xIm = xRe + blockSize;
+            const float* hRe = spectra.spectra.data() + static_cast<size_t>(p * stride);
+            const float* hIm = hRe + blockSize;
+
+            for (int k = 0; k < blockSize; k += V::SIZE)
+            {
+                const V xr = V::load(xRe + k), xi = V::load(xIm + k);
+                const V hr = V::load(hRe + k), hi = V::load(hIm + k);
+                (V::load(accRe + k) + xr * hr - xi * hi).store(accRe + k);
+                (V::load(accIm + k) + xr * hi + xi * hr).store(accIm + k);
+            }
+            dc += xRe[0] * hRe[0];
+            nyquist += xIm[0] * hIm[0];
+
+            slot = slot > 0 ? slot - 1 : segment.numSlots - 1;
+        }
+        accRe[0] = dc;
+        accIm[0] = nyquist;
+
+        // オーバーラップセーブ: 後半 B サンプルが線形畳み込みの結果
+        segment.fft.inverse(accRe, accIm, segment.time.data());
+        std::copy(segment.time.begin() + blockSize, segment.time.end(), segment.output.begin());
+    }
+
+    Segment segments[PartitionedConvolution::NUM_SEGMENTS];
+};
@@ -0,0 +1,174 @@
+#pragma once
+#include "DspCommon.h"
+#include "SimdFloat4.h"
+#include <cmath>
+#include <utility>
+#include <vector>
+
+//==============================================================================
+// 実数FFT（2のべき乗長 N、確保は setSize のみ）
+// スペクトルは実部・虚部を別配列に持つ N/2 ビンのパック形式で、re[0] = 直流、
+// im[0] = ナイキスト（どちらも実数）。正規化なしで、inverse(forward(x)) = N·x
+// 実数列を長さ N/2 の複素列に詰めて1回の複素FFTで変換し、バタフライは4組ずつSIMDで行う
+//==============================================================================
+class RealFft
+{
+public:
+    static constexpr int MIN_SIZE = 16;
+
+    void setSize(int newSize)
+    {
+        size = newSize;
+        half = newSize / 2;
+
+        // ビット反転の入れ替え表（i < j の組だけ）
+        int bits = 0;
+        while ((1 << bits) < half) ++bits;
+        swaps.clear();
+        for (int i = 0; i < half; ++i)
+        {
+            int j = 0;
+            for (int b = 0; b < bits; ++b)
+                j |= ((i >> b) & 1) << (bits - 1 - b);
+            if (i < j)
+                swaps.push_back({ i, j });
+        }
+
+        // 段ごとの回転因子 e^(-iπj/h)（h = 1, 2, 4, ... を連続に並べる。段 h は twiddle + h - 1 から）
+        constexpr double pi = DspConstants<double>::pi;
+        twiddleRe.assign(static_cast<size_t>(half), 0.0f);
+        twiddleIm.assign(static_cast<size_t>(half), 0.0f);
+        for (int h = 1; h < half; h <<= 1)
+            for (int j = 0; j < h; ++j)
+            {
+                twiddleRe[static_cast<size_t>(h - 1 + j)] = static_cast<float>(std::cos(pi * j / h));
+                twiddleIm[static_cast<size_t>(h - 1 + j)] = static_cast<float>(-std::sin(pi * j / h));
+            }
+
+        // 実数化の回転因子 e^(-2πik/N)
+        splitRe.assign(static_cast<size_t>(half), 0.0f);
+        splitIm.assign(static_cast<size_t>(half), 0.0f);
+        for (int k = 0; k < half; ++k)
+        {
+            splitRe[static_cast<size_t>(k)] = static_cast<float>(std::cos(2.0 * pi * k / size));
+            splitIm[static_cast<size_t>(k)] = static_cast<float>(-std::sin(2.0 * pi * k / size));
+        }
+    }
+
+    int getSize() const { return size; }
+
+    // time: N サンプル → re / im: N/2（re / im は16バイト境界、time とは別の領域）
+    void forward(const float* time, float* re, float* im) const
+    {
+        for (int n = 0; n < half; ++n)
+        {
+            re[n] = time[2 * n];
+            im[n] = time[2 * n + 1];
+        }
+        complexTransform(re, im);
+
+        // Z = FFT(x偶 + i·x奇) から X[k] = E + W^k·O、X[N/2 - k] = conj(E - W^k·O)
+        const float dc = re[0] + im[0];
+        const float nyquist = re[0] - im[0];
+        re[0] = dc;
+        im[0] = nyquist;
+        for (int k = 1; k <= half / 2; ++k)
+        {
+            const int m = half - k;
+            const float er = 0.5f * (re[k] + re[m]), ei = 0.5f * (im[k] - im[m]);
+            const float orr = 0.5f * (im[k] + im[m]), oi = -0.5f * (re[k] - re[m]);
+            const float wr = splitRe[static_cast<size_t>(k)], wi = splitIm[static_cast<size_t>(k)];
+            const float tr = wr * orr - wi * oi, ti = wr * oi + wi * orr;
+            re[k] = er + tr;
+            im[k] = ei + ti;
+            re[m] = er - tr;
+            im[m] = -(ei - ti);
+        }
+    }
+
+    // re / im: N/2（作業領域として上書きされる）→ time: N サンプル
+    void inverse(float* re, float* im, float* time) const
+    {
+        // forward の逆: E = X[k] + conj(X[N/2 - k])、O = (X[k] - conj(X[N/2 - k]))·conj(W^k)、Z = E + i·O
+        const float dc = re[0], nyquist = im[0];
+        re[0] = dc + nyquist;
+        im[0] = dc - nyquist;
+        for (int k = 1; k <= half / 2; ++k)
+        {
+            const int m = half - k;
+            const float er = re[k] + re[m], ei = im[k] - im[m];
+            const float dr = re[k] - re[m], di = im[k] + im[m];
+            const float wr = splitRe[static_cast<size_t>(k)], wi = -splitIm[static_cast<size_t>(k)];
+            const float orr = dr * wr - di * wi, oi = dr * wi + di * wr;
+            re[k] = er - oi;
+            im[k] = ei + orr;
+            re[m] = er + oi;
+            im[m] = orr - ei;
+        }
+
+        // 逆変換は実部と虚部を入れ替えた順変換
+        complexTransform(im, re);
+        for (int n = 0; n < half; ++n)
+        {
+            time[2 * n] = re[n];
+            time[2 * n + 1] = im[n];
+        }
+    }
+
+private:
+    // 長さ N/2 の複素FFT（インプレース、時間間引き）
+    void complexTransform(float* re, float* im) const
+    {
+        for (const auto& [i, j] : swaps)
+        {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+
+        using V = SimdFloat4;
+        for (int h = 1; h < half; h <<= 1)
+        {
+            const float* wRe = twiddleRe.data() + h - 1;
+            const float* wIm = twiddleIm.data() + h - 1;
+            for (int block = 0; block < half; block += h * 2)
+            {
+                float* aRe = re + block;
+                float* aIm = im + block;
+                float* bRe = aRe + h;
+                float* bIm = aIm + h;
+
+                if (h < V::SIZE)
+                {
+                    for (int j = 0; j < h; ++j)
+                    {
+                        const float tr = wRe[j] * bRe[j] - wIm[j] * bIm[j];
+                        const float ti = wRe[j] * bIm[j] + wIm[j] * bRe[j];
+                        bRe[j] = aRe[j] - tr;
+                        bIm[j] = aIm[j] - ti;
+                        aRe[j] += tr;
+                        aIm[j] += ti;
+                    }
+                    continue;
+                }
+
+                for (int j = 0; j < h; j += V::SIZE)
+                {
+                    const V wr = V::loadUnaligned(wRe + j), wi = V::loadUnaligned(wIm + j);
+                    const V br = V::load(bRe + j), bi = V::load(bIm + j);
+                    const V ar = V::load(aRe + j), ai = V::load(aIm + j);
+                    const V tr = wr * br - wi * bi;
+                    const V ti = wr * bi + wi * br;
+                    (ar - tr).store(bRe + j);
+                    (ai - ti).store(bIm + j);
+                    (ar + tr).store(aRe + j);
+                    (ai + ti).store(aIm + j);
+                }
+            }
+        }
+    }
+
+    int size = 0, half = 0;
+    std::vector<std::pair<int, int>> swaps;
+    std::vector<float> twiddleRe, twiddleIm;
+    std::vector<float> splitRe, splitIm;
+};
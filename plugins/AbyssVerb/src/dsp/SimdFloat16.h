@@ -0,0 +1,90 @@
+#pragma once
+#include "SimdFloat8.h"
+
+//==============================================================================
+// 16レーンSIMDレジスタ (AVX-512F)
+// -mavx512f（/arch:AVX512）でコンパイルする翻訳単位（DspKernelsAvx512.cpp）専用。
+// AVX-512F だけで書けるよう、ビット演算は整数命令で行う（_mm512_and_ps などは AVX-512DQ）
+//==============================================================================
+struct SimdFloat16
+{
+    static constexpr int SIZE = 16;
+
+    __m512 v;
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 load(const float* p) noexcept { return { _mm512_loadu_ps(p) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 broadcast(float x) noexcept   { return { _mm512_set1_ps(x) }; }
+    ABYSSVERB_SIMD_INLINE void store(float* p) const noexcept              { _mm512_storeu_ps(p, v); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 loadUnaligned(const float* p) noexcept { return load(p); }
+    ABYSSVERB_SIMD_INLINE void storeUnaligned(float* p) const noexcept             { store(p); }
+
+    friend ABYSSVERB_SIMD_INLINE SimdFloat16 operator+(SimdFloat16 a, SimdFloat16 b) noexcept { return { _mm512_add_ps(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat16 operator-(SimdFloat16 a, SimdFloat16 b) noexcept { return { _mm512_sub_ps(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat16 operator*(SimdFloat16 a, SimdFloat16 b) noexcept { return { _mm512_mul_ps(a.v, b.v) }; }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 abs(SimdFloat16 a) noexcept
+    {
+        return { _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(0x7fffffff))) };
+    }
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 min(SimdFloat16 a, SimdFloat16 b) noexcept { return { _mm512_min_ps(a.v, b.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 max(SimdFloat16 a, SimdFloat16 b) noexcept { return { _mm512_max_ps(a.v, b.v) }; }
+
+    // |a| < 2^31 の範囲で切り捨て（SimdFloat4::floor と同じ手順）
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 floor(SimdFloat16 a) noexcept
+    {
+        const __m512 t = _mm512_cvtepi32_ps(_mm512_cvttps_epi32(a.v));
+        return { _mm512_mask_sub_ps(t, _mm512_cmp_ps_mask(t, a.v, _CMP_GT_OQ), t, _mm512_set1_ps(1.0f)) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 pow2(SimdFloat16 k) noexcept
+    {
+        return { _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvttps_epi32(k.v), _mm512_set1_epi32(127)), 23)) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 copySign(SimdFloat16 magnitude, SimdFloat16 sign) noexcept
+    {
+        const __m512i signMask = _mm512_set1_epi32(INT32_MIN);
+        return { _mm512_castsi512_ps(_mm512_ternarylogic_epi32(signMask, _mm512_castps_si512(sign.v),
+                                                               _mm512_castps_si512(magnitude.v), 0xCA)) };
+    }
+
+    // レジスタ内のウォルシュ・アダマール変換（正規化なし、fastWalshHadamard<16> と同じ演算順）
+    static ABYSSVERB_SIMD_INLINE SimdFloat16 hadamard(SimdFloat16 a) noexcept
+    {
+        const __m512 s1 = butterfly(_mm512_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 2, 0, 0)),
+                                    _mm512_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 3, 1, 1)), 0xAAAA);
+        const __m512 s2 = butterfly(_mm512_shuffle_ps(s1, s1, _MM_SHUFFLE(1, 0, 1, 0)),
+                                    _mm512_shuffle_ps(s1, s1, _MM_SHUFFLE(3, 2, 3, 2)), 0xCCCC);
+        const __m512 s4 = butterfly(_mm512_shuffle_f32x4(s2, s2, _MM_SHUFFLE(2, 2, 0, 0)),
+                                    _mm512_shuffle_f32x4(s2, s2, _MM_SHUFFLE(3, 3, 1, 1)), 0xF0F0);
+        return { butterfly(_mm512_shuffle_f32x4(s4, s4, _MM_SHUFFLE(1, 0, 1, 0)),
+                           _mm512_shuffle_f32x4(s4, s4, _MM_SHUFFLE(3, 2, 3, 2)), 0xFF00) };
+    }
+
+    // rows[l] + offset から4個ずつ読み、out[k] のレーン l = rows[l][offset + k] に並べ替える（k < 4）
+    static ABYSSVERB_SIMD_INLINE void transpose4(const float* const* rows, int offset, SimdFloat16 out[4]) noexcept
+    {
+        // 128ビットの区画 q に行 l + 4q を置けば、各区画の中で4×4の転置になる
+        __m512 r[4];
+        for (int l = 0; l < 4; ++l)
+        {
+            __m512 row = _mm512_castps128_ps512(_mm_loadu_ps(rows[l] + offset));
+            row = _mm512_insertf32x4(row, _mm_loadu_ps(rows[l + 4] + offset), 1);
+            row = _mm512_insertf32x4(row, _mm_loadu_ps(rows[l + 8] + offset), 2);
+            r[l] = _mm512_insertf32x4(row, _mm_loadu_ps(rows[l + 12] + offset), 3);
+        }
+        const __m512 t0 = _mm512_unpacklo_ps(r[0], r[1]), t1 = _mm512_unpackhi_ps(r[0], r[1]);
+        const __m512 t2 = _mm512_unpacklo_ps(r[2], r[3]), t3 = _mm512_unpackhi_ps(r[2], r[3]);
+        out[0] = { _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)) };
+        out[1] = { _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)) };
+        out[2] = { _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)) };
+        out[3] = { _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)) };
+    }
+
+private:
+    // a + b（differenceLanes のレーンは a - b）
+    static ABYSSVERB_SIMD_INLINE __m512 butterfly(__m512 a, __m512 b, __mmask16 differenceLanes) noexcept
+    {
+        return _mm512_mask_sub_ps(_mm512_add_ps(a, b), differenceLanes, a, b);
+    }
+};
@@ -0,0 +1,231 @@
+#pragma once
+#include "DspCommon.h"
+#include <cmath>
+
+//==============================================================================
+// 4レーンSIMDレジスタ (SSE2 / NEON / スカラーフォールバック)
+// load/store は16バイト境界に揃ったアドレスを前提とする（loadUnaligned/storeUnaligned は任意）
+//==============================================================================
+struct SimdFloat4
+{
+    static constexpr int SIZE = 4;
+
+#if ABYSSVERB_SIMD_SSE
+    __m128 v;
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 load(const float* p) noexcept { return { _mm_load_ps(p) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 broadcast(float x) noexcept   { return { _mm_set1_ps(x) }; }
+    ABYSSVERB_SIMD_INLINE void store(float* p) const noexcept              { _mm_store_ps(p, v); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 loadUnaligned(const float* p) noexcept { return { _mm_loadu_ps(p) }; }
+    ABYSSVERB_SIMD_INLINE void storeUnaligned(float* p) const noexcept             { _mm_storeu_ps(p, v); }
+
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 abs(SimdFloat4 a) noexcept { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+
+    // |a| < 2^31 の範囲で切り捨て
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 floor(SimdFloat4 a) noexcept
+    {
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+        return { _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f))) };
+    }
+
+    // 2^k（k は -126〜127 の整数値）を指数部の組み立てで作る
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 pow2(SimdFloat4 k) noexcept
+    {
+        return { _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(k.v), _mm_set1_epi32(127)), 23)) };
+    }
+
+    // magnitude の絶対値に sign の符号を付ける
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 copySign(SimdFloat4 magnitude, SimdFloat4 sign) noexcept
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        return { _mm_or_ps(_mm_andnot_ps(signMask, magnitude.v), _mm_and_ps(signMask, sign.v)) };
+    }
+
+    // [first, a0, a1, a2] — 1サンプル前の値の列（1次漸化式の入力差分用）
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 shiftIn(float first, SimdFloat4 a) noexcept
+    {
+        return { _mm_move_ss(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 1, 0, 0)), _mm_set_ss(first)) };
+    }
+
+    template <int Lane>
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 splat(SimdFloat4 a) noexcept { return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)) }; }
+
+    template <int Lane>
+    ABYSSVERB_SIMD_INLINE float get() const noexcept { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane))); }
+
+    // 4レーンの総和（(a0 + a2) + (a1 + a3)）
+    ABYSSVERB_SIMD_INLINE float sum() const noexcept
+    {
+        const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    // a >= b のレーンは x、それ以外は 0
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 selectGE(SimdFloat4 a, SimdFloat4 b, SimdFloat4 x) noexcept
+    {
+        return { _mm_and_ps(_mm_cmpge_ps(a.v, b.v), x.v) };
+    }
+
+    // レジスタ内のウォルシュ・アダマール変換（正規化なし、fastWalshHadamard<4> と同じ演算順）
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 hadamard(SimdFloat4 a) noexcept
+    {
+        const __m128 oddLanes = _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, 0, INT32_MIN, 0));
+        const __m128 upperLanes = _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, INT32_MIN, 0, 0));
+        const __m128 s = _mm_add_ps(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 2, 0, 0)),
+                                    _mm_xor_ps(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 3, 1, 1)), oddLanes));
+        return { _mm_add_ps(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 1, 0)),
+                            _mm_xor_ps(_mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 2, 3, 2)), upperLanes)) };
+    }
+
+    // rows[l] + offset から4個ずつ読み、out[k] のレーン l = rows[l][offset + k] に並べ替える
+    static ABYSSVERB_SIMD_INLINE void transpose4(const float* const* rows, int offset, SimdFloat4 out[4]) noexcept
+    {
+        __m128 r0 = _mm_loadu_ps(rows[0] + offset), r1 = _mm_loadu_ps(rows[1] + offset);
+        __m128 r2 = _mm_loadu_ps(rows[2] + offset), r3 = _mm_loadu_ps(rows[3] + offset);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        out[0] = { r0 }; out[1] = { r1 }; out[2] = { r2 }; out[3] = { r3 };
+    }
+#elif ABYSSVERB_SIMD_NEON
+    float32x4_t v;
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 load(const float* p) noexcept { return { vld1q_f32(p) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 broadcast(float x) noexcept   { return { vdupq_n_f32(x) }; }
+    ABYSSVERB_SIMD_INLINE void store(float* p) const noexcept              { vst1q_f32(p, v); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 loadUnaligned(const float* p) noexcept { return { vld1q_f32(p) }; }
+    ABYSSVERB_SIMD_INLINE void storeUnaligned(float* p) const noexcept             { vst1q_f32(p, v); }
+
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) noexcept { return { vaddq_f32(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) noexcept { return { vsubq_f32(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) noexcept { return { vmulq_f32(a.v, b.v) }; }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 abs(SimdFloat4 a) noexcept { return { vabsq_f32(a.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) noexcept { return { vminq_f32(a.v, b.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) noexcept { return { vmaxq_f32(a.v, b.v) }; }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 floor(SimdFloat4 a) noexcept
+    {
+        const float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(a.v));
+        const uint32x4_t greater = vcgtq_f32(t, a.v);
+        return { vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(greater, vreinterpretq_u32_f32(vdupq_n_f32(1.0f))))) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 pow2(SimdFloat4 k) noexcept
+    {
+        return { vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(k.v), vdupq_n_s32(127)), 23)) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 copySign(SimdFloat4 magnitude, SimdFloat4 sign) noexcept
+    {
+        return { vbslq_f32(vdupq_n_u32(0x80000000u), sign.v, magnitude.v) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 shiftIn(float first, SimdFloat4 a) noexcept { return { vextq_f32(vdupq_n_f32(first), a.v, 3) }; }
+
+    template <int Lane>
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 splat(SimdFloat4 a) noexcept { return { vdupq_n_f32(vgetq_lane_f32(a.v, Lane)) }; }
+
+    template <int Lane>
+    ABYSSVERB_SIMD_INLINE float get() const noexcept { return vgetq_lane_f32(v, Lane); }
+
+    ABYSSVERB_SIMD_INLINE float sum() const noexcept
+    {
+        const float32x2_t pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 selectGE(SimdFloat4 a, SimdFloat4 b, SimdFloat4 x) noexcept
+    {
+        return { vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(a.v, b.v), vreinterpretq_u32_f32(x.v))) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 hadamard(SimdFloat4 a) noexcept
+    {
+        static constexpr std::uint32_t oddSigns[4] = { 0u, 0x80000000u, 0u, 0x80000000u };
+        static constexpr std::uint32_t upperSigns[4] = { 0u, 0u, 0x80000000u, 0x80000000u };
+        const uint32x4_t oddLanes = vld1q_u32(oddSigns), upperLanes = vld1q_u32(upperSigns);
+        const float32x4x2_t pairs = vtrnq_f32(a.v, a.v);
+        const float32x4_t s = vaddq_f32(pairs.val[0], vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(pairs.val[1]), oddLanes)));
+        const float32x4_t lower = vcombine_f32(vget_low_f32(s), vget_low_f32(s));
+        const float32x4_t upper = vcombine_f32(vget_high_f32(s), vget_high_f32(s));
+        return { vaddq_f32(lower, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(upper), upperLanes))) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE void transpose4(const float* const* rows, int offset, SimdFloat4 out[4]) noexcept
+    {
+        const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(rows[0] + offset), vld1q_f32(rows[1] + offset));
+        const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(rows[2] + offset), vld1q_f32(rows[3] + offset));
+        out[0] = { vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])) };
+        out[1] = { vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])) };
+        out[2] = { vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])) };
+        out[3] = { vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])) };
+    }
+#else
+    float v[SIZE];
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 load(const float* p) noexcept { return { { p[0], p[1], p[2], p[3] } }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 broadcast(float x) noexcept   { return { { x, x, x, x } }; }
+    ABYSSVERB_SIMD_INLINE void store(float* p) const noexcept              { for (int i = 0; i < SIZE; ++i) p[i] = v[i]; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 loadUnaligned(const float* p) noexcept { return load(p); }
+    ABYSSVERB_SIMD_INLINE void storeUnaligned(float* p) const noexcept             { store(p); }
+
+    template <typename Op>
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 map(SimdFloat4 a, SimdFloat4 b, Op op) noexcept
+    {
+        SimdFloat4 r;
+        for (int i = 0; i < SIZE; ++i) r.v[i] = op(a.v[i], b.v[i]);
+        return r;
+    }
+
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) noexcept { return map(a, b, [](float x, float y) { return x + y; }); }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) noexcept { return map(a, b, [](float x, float y) { return x - y; }); }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) noexcept { return map(a, b, [](float x, float y) { return x * y; }); }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 abs(SimdFloat4 a) noexcept { return map(a, a, [](float x, float) { return std::abs(x); }); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) noexcept { return map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) noexcept { return map(a, b, [](float x, float y) { return x < y ? y : x; }); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 floor(SimdFloat4 a) noexcept { return map(a, a, [](float x, float) { return std::floor(x); }); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 pow2(SimdFloat4 k) noexcept { return map(k, k, [](float x, float) { return std::ldexp(1.0f, static_cast<int>(x)); }); }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 copySign(SimdFloat4 magnitude, SimdFloat4 sign) noexcept
+    {
+        return map(magnitude, sign, [](float m, float s) { return std::copysign(m, s); });
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 shiftIn(float first, SimdFloat4 a) noexcept { return { { first, a.v[0], a.v[1], a.v[2] } }; }
+
+    template <int Lane>
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 splat(SimdFloat4 a) noexcept { return broadcast(a.v[Lane]); }
+
+    template <int Lane>
+    ABYSSVERB_SIMD_INLINE float get() const noexcept { return v[Lane]; }
+
+    ABYSSVERB_SIMD_INLINE float sum() const noexcept { return (v[0] + v[2]) + (v[1] + v[3]); }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 selectGE(SimdFloat4 a, SimdFloat4 b, SimdFloat4 x) noexcept
+    {
+        SimdFloat4 r;
+        for (int i = 0; i < SIZE; ++i) r.v[i] = a.v[i] >= b.v[i] ? x.v[i] : 0.0f;
+        return r;
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat4 hadamard(SimdFloat4 a) noexcept
+    {
+        const float s0 = a.v[0] + a.v[1], s1 = a.v[0] - a.v[1];
+        const float s2 = a.v[2] + a.v[3], s3 = a.v[2] - a.v[3];
+        return { { s0 + s2, s1 + s3, s0 - s2, s1 - s3 } };
+    }
+
+    static ABYSSVERB_SIMD_INLINE void transpose4(const float* const* rows, int offset, SimdFloat4 out[4]) noexcept
+    {
+        for (int k = 0; k < SIZE; ++k)
+            for (int l = 0; l < SIZE; ++l)
+                out[k].v[l] = rows[l][offset + k];
+    }
+#endif
+};
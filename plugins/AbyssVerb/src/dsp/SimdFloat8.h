@@ -0,0 +1,84 @@
+#pragma once
+#include "SimdFloat4.h"
+#include <immintrin.h>
+
+//==============================================================================
+// 8レーンSIMDレジスタ (AVX2)
+// -mavx2（/arch:AVX2）でコンパイルする翻訳単位（DspKernelsAvx2.cpp / DspKernelsAvx512.cpp）専用。
+// 演算は SimdFloat4 とレーンごとに同じなので、同じ式なら4レーン版とビット単位で一致する。
+// load/store は境界を問わない（FDN の配列は16バイト境界までしか揃えていない）
+//==============================================================================
+struct SimdFloat8
+{
+    static constexpr int SIZE = 8;
+
+    __m256 v;
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 load(const float* p) noexcept { return { _mm256_loadu_ps(p) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 broadcast(float x) noexcept   { return { _mm256_set1_ps(x) }; }
+    ABYSSVERB_SIMD_INLINE void store(float* p) const noexcept              { _mm256_storeu_ps(p, v); }
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 loadUnaligned(const float* p) noexcept { return load(p); }
+    ABYSSVERB_SIMD_INLINE void storeUnaligned(float* p) const noexcept             { store(p); }
+
+    friend ABYSSVERB_SIMD_INLINE SimdFloat8 operator+(SimdFloat8 a, SimdFloat8 b) noexcept { return { _mm256_add_ps(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat8 operator-(SimdFloat8 a, SimdFloat8 b) noexcept { return { _mm256_sub_ps(a.v, b.v) }; }
+    friend ABYSSVERB_SIMD_INLINE SimdFloat8 operator*(SimdFloat8 a, SimdFloat8 b) noexcept { return { _mm256_mul_ps(a.v, b.v) }; }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 abs(SimdFloat8 a) noexcept { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 min(SimdFloat8 a, SimdFloat8 b) noexcept { return { _mm256_min_ps(a.v, b.v) }; }
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 max(SimdFloat8 a, SimdFloat8 b) noexcept { return { _mm256_max_ps(a.v, b.v) }; }
+
+    // |a| < 2^31 の範囲で切り捨て（SimdFloat4::floor と同じ手順）
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 floor(SimdFloat8 a) noexcept
+    {
+        const __m256 t = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a.v));
+        return { _mm256_sub_ps(t, _mm256_and_ps(_mm256_cmp_ps(t, a.v, _CMP_GT_OQ), _mm256_set1_ps(1.0f))) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 pow2(SimdFloat8 k) noexcept
+    {
+        return { _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(k.v), _mm256_set1_epi32(127)), 23)) };
+    }
+
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 copySign(SimdFloat8 magnitude, SimdFloat8 sign) noexcept
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        return { _mm256_or_ps(_mm256_andnot_ps(signMask, magnitude.v), _mm256_and_ps(signMask, sign.v)) };
+    }
+
+    // 上下4レーンを足してから SimdFloat4::sum（4レーン2本の積和を足す順序と一致する）
+    ABYSSVERB_SIMD_INLINE float sum() const noexcept
+    {
+        return SimdFloat4 { _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)) }.sum();
+    }
+
+    // レジスタ内のウォルシュ・アダマール変換（正規化なし、fastWalshHadamard<8> と同じ演算順）
+    static ABYSSVERB_SIMD_INLINE SimdFloat8 hadamard(SimdFloat8 a) noexcept
+    {
+        const __m256 oddLanes = _mm256_castsi256_ps(_mm256_set_epi32(INT32_MIN, 0, INT32_MIN, 0, INT32_MIN, 0, INT32_MIN, 0));
+        const __m256 upperPairs = _mm256_castsi256_ps(_mm256_set_epi32(INT32_MIN, INT32_MIN, 0, 0, INT32_MIN, INT32_MIN, 0, 0));
+        const __m256 upperHalf = _mm256_castsi256_ps(_mm256_set_epi32(INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 0, 0, 0, 0));
+        const __m256 s1 = _mm256_add_ps(_mm256_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 2, 0, 0)),
+                                        _mm256_xor_ps(_mm256_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 3, 1, 1)), oddLanes));
+        const __m256 s2 = _mm256_add_ps(_mm256_shuffle_ps(s1, s1, _MM_SHUFFLE(1, 0, 1, 0)),
+                                        _mm256_xor_ps(_mm256_shuffle_ps(s1, s1, _MM_SHUFFLE(3, 2, 3, 2)), upperPairs));
+        return { _mm256_add_ps(_mm256_permute2f128_ps(s2, s2, 0x00),
+                               _mm256_xor_ps(_mm256_permute2f128_ps(s2, s2, 0x11), upperHalf)) };
+    }
+
+    // rows[l] + offset から4個ずつ読み、out[k] のレーン l = rows[l][offset + k] に並べ替える（k < 4）
+    static ABYSSVERB_SIMD_INLINE void transpose4(const float* const* rows, int offset, SimdFloat8 out[4]) noexcept
+    {
+        // 行 l を下位、行 l + 4 を上位に置けば、128ビットの各半分の中で4×4の転置になる
+        __m256 r[4];
+        for (int l = 0; l < 4; ++l)
+            r[l] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(rows[l] + offset)),
+                                        _mm_loadu_ps(rows[l + 4] + offset), 1);
+        const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpackhi_ps(r[0], r[1]);
+        const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+        out[0] = { _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)) };
+        out[1] = { _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)) };
+        out[2] = { _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)) };
+        out[3] = { _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)) };
+    }
+};
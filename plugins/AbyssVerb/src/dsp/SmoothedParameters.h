@@ -0,0 +1,186 @@
+#pragma once
+#include "AbyssVerbParameters.h"
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+//==============================================================================
+// パラメーターランプエンジン — クリックノイズを防止
+// 動いているパラメーターだけをブロック単位のランプバッファに展開し、
+// 静止しているパラメーターには一切手を付けない
+//==============================================================================
+class SmoothedParameters
+{
+public:
+    static constexpr int NUM_PARAMS = NUM_SMOOTHED_PARAMS;
+
+    enum class RampShape { linear, exponential };
+
+    // 指数ランプが目標値に吸着する距離の既定はパラメーターの範囲の SETTLE_FRACTION
+    SmoothedParameters()
+    {
+        for (int i = 0; i < NUM_PARAMS; ++i)
+            params[i].settleThreshold = SETTLE_FRACTION * (paramSpecs[i].maxValue - paramSpecs[i].minValue);
+    }
+
+    // ランプバッファを確保（prepareToPlay から呼ぶ）。確保済みの長さに収まるブロック長なら確保し直さない。
+    // setRampTime で決めた時間と形はそのままで、サンプル数だけ新しいレートで求め直す
+    void reset(double sampleRate, int maxBlockSize)
+    {
+        sr = sampleRate;
+        blockCapacity = std::max(1, maxBlockSize);
+        reserve(blockCapacity);
+
+        for (auto& p : params)
+            updateRampLength(p);
+        numActive = 0;
+    }
+
+    // maxBlockSize までのブロック長をあらかじめ確保しておく（後の reset で確保しないように）
+    void reserve(int maxBlockSize)
+    {
+        const auto size = static_cast<size_t>(NUM_PARAMS * std::max(1, maxBlockSize));
+        if (rampBuffers.size() < size)
+            rampBuffers.assign(size, 0.0f);
+    }
+
+    // パラメーターごとのランプ時間と形（既定は全パラメーター約10msの指数ランプ）。
+    // prepare の前に呼んでよく、以後の reset でも保たれる
+    void setRampTime(Param param, float seconds, RampShape shape)
+    {
+        auto& p = params[index(param)];
+        p.shape = shape;
+        p.seconds = seconds;
+        updateRampLength(p);
+    }
+
+    // 指数ランプが目標値に吸着する距離（パラメーターの単位の絶対値）。
+    // 吸着はその距離の段差になるので、段差が聞こえるパラメーターは既定より小さくする
+    void setSettleThreshold(Param param, float threshold)
+    {
+        params[index(param)].settleThreshold = threshold;
+    }
+
+    // ランプなしで現在値を確定させる
+    void setCurrentValues(const ParamSnapshot& values)
+    {
+        for (int i = 0; i < NUM_PARAMS; ++i)
+        {
+            params[i].current = params[i].target = values.values[i];
+            params[i].remaining = 0;
+            ramping[i] = false;
+        }
+        numActive = 0;
+    }
+
+    // ブロック開始: 目標値を受け取り、動いているパラメーターだけランプを展開する
+    // numSamples は getMaxBlockSize() 以下であること
+    void beginBlock(const ParamSnapshot& targets, int numSamples)
+    {
+        numActive = 0;
+
+        for (int i = 0; i < NUM_PARAMS; ++i)
+        {
+            auto& p = params[i];
+
+            if (targets.values[i] != p.target)
+            {
+                p.target = targets.values[i];
+                p.remaining = p.rampSamples;
+                p.step = (p.target - p.current) / static_cast<float>(p.rampSamples);
+            }
+
+            ramping[i] = p.current != p.target;
+            if (! ramping[i])
+                continue;
+
+            ++numActive;
+            float* buffer = rampBuffers.data() + i * blockCapacity;
+            float value = p.current;
+
+            if (p.shape == RampShape::linear)
+            {
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    value = (p.remaining > 0 && --p.remaining > 0) ? value + p.step : p.target;
+                    buffer[n] = value;
+                }
+            }
+            else
+            {
+                // 目標値との差を減衰させる（差に掛けるので float の分解能で途中で止まらない）
+                float remainder = p.current - p.target;
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    remainder *= p.expDecay;
+                    buffer[n] = p.target + remainder;
+                }
+
+                // settleThreshold まで近づいたら目標値に吸着し、次のブロックから静止扱いにする
+                value = std::abs(remainder) <= p.settleThreshold ? p.target : p.target + remainder;
+            }
+
+            p.current = value;
+        }
+    }
+
+    // このブロックで動いているパラメーターが1つもなければ true
+    bool isBlockStatic() const { return numActive == 0; }
+    bool isRamping(Param param) const { return ramping[index(param)]; }
+
+    // ブロック内 sample 番目の値
+    float get(Param param, int sample) const
+    {
+        const int i = index(param);
+        return ramping[i] ? rampBuffers[static_cast<size_t>(i * blockCapacity + sample)]
+                          : params[i].current;
+    }
+
+    // ランプ中のパラメーターのブロックバッファ（静止中は nullptr）
+    const float* getRampBuffer(Param param) const
+    {
+        const int i = index(param);
+        return ramping[i] ? rampBuffers.data() + i * blockCapacity : nullptr;
+    }
+
+    int getMaxBlockSize() const { return blockCapacity; }
+
+private:
+    static constexpr float SETTLE_FRACTION = 1.0e-4f;
+
+    static int index(Param param)
+    {
+        const int i = static_cast<int>(param);
+        assert(i >= 0 && i < NUM_PARAMS);
+        return i;
+    }
+
+    struct Ramp
+    {
+        float current = 0.0f, target = 0.0f;
+        RampShape shape = RampShape::exponential;
+        float seconds = 0.01f;
+        int rampSamples = 1;
+        // 線形ランプ
+        float step = 0.0f;
+        int remaining = 0;
+        // 指数ランプ（1サンプルごとに目標値との差に掛ける係数と、吸着する距離）
+        float expDecay = 0.0f;
+        float settleThreshold = 0.0f;
+    };
+
+    // 時間 [s] からランプのサンプル数と指数ランプの係数を求める
+    void updateRampLength(Ramp& p) const
+    {
+        p.rampSamples = std::max(1, static_cast<int>(p.seconds * static_cast<float>(sr)));
+        p.expDecay = std::exp(-1.0f / (static_cast<float>(sr) * p.seconds));
+    }
+
+    double sr = 48000.0;
+    int blockCapacity = 0;
+    Ramp params[NUM_PARAMS];
+    bool ramping[NUM_PARAMS] = {};
+    int numActive = 0;
+    std::vector<float> rampBuffers;
+};
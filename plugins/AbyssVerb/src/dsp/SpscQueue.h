@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+// 単一生産者・単一消費者のロックフリー・リングバッファ（固定容量、確保なし）
+// push は1つのスレッド（オーディオスレッド）、pop は別の1つのスレッドからだけ呼ぶ。
+// 満杯なら push は要素を捨てて false を返す（オーディオスレッドは消費者を待たない）
+//==============================================================================
+template <typename T, int Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr int CAPACITY = Capacity;
+
+    // 生産者側
+    bool push(const T& item)
+    {
+        const auto write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) >= static_cast<std::uint32_t>(Capacity))
+            return false;
+
+        slots[write & MASK] = item;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消費者側: 空なら false
+    bool pop(T& item)
+    {
+        const auto read = readIndex.load(std::memory_order_relaxed);
+        if (read == writeIndex.load(std::memory_order_acquire))
+            return false;
+
+        item = slots[read & MASK];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消費者側: 溜まっている要素を捨てる
+    void discard()
+    {
+        readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // どちらの側からも: 溜まっている要素数（読んだ時点の目安）
+    int size() const
+    {
+        return static_cast<int>(writeIndex.load(std::memory_order_acquire)
+                                - readIndex.load(std::memory_order_acquire));
+    }
+
+private:
+    static constexpr std::uint32_t MASK = static_cast<std::uint32_t>(Capacity - 1);
+
+    std::array<T, Capacity> slots {};
+
+    // 生産者と消費者が書く添字は別のキャッシュラインに置く（フォルスシェアリング回避）
+    alignas(64) std::atomic<std::uint32_t> writeIndex { 0 };
+    alignas(64) std::atomic<std::uint32_t> readIndex { 0 };
+};
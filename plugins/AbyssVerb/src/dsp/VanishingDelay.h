@@ -0,0 +1,333 @@
+#pragma once
+#include "DspCommon.h"
+#include "DelayMemoryArena.h"
+#include "LfoBank.h"
+#include "FastRandom.h"
+#include "FractionalDelay.h"
+#include <cmath>
+#include <algorithm>
+
+//==============================================================================
+// 消失ディレイ — バイオリン版: 弓圧反応 + ピッチドリフト
+//==============================================================================
+class VanishingDelay
+{
+public:
+    static constexpr int NUM_TAPS = 4; // 4タップ（バイオリンの4弦に呼応するイメージ）
+
+    // バッファはこれまでに準備した最も高いレート（MAX_PREPARED_SAMPLE_RATE を指定していればそれ以上）の
+    // 長さで確保し、使うのは今のレートの MAX_DELAY_SECONDS 分だけ。容量に収まるレートへの切替は
+    // 確保し直さず、エコーと消失スケジュールを残したまま新しいレートへ変換する
+    void prepare(double sampleRate, int /*samplesPerBlock*/)
+    {
+        const double previousRate = sr;
+        sr = sampleRate;
+        maxDelaySamples = static_cast<int>(sr * MAX_DELAY_SECONDS);
+        capacityRate = std::max({ capacityRate, sr, MAX_PREPARED_SAMPLE_RATE });
+        const int capacity = static_cast<int>(capacityRate * MAX_DELAY_SECONDS);
+        const bool allocated = arena.allocate(&capacity, 1, &buffer);
+        const int size = DelayMemoryArena::nextPowerOfTwo(maxDelaySamples);
+        FractionalDelay::Sinc::table(); // 係数表をオーディオスレッドより先に作る
+
+        // スムージング（1サンプルあたり SMOOTH_RATE の1次ローパス）を L サンプル進めたときの残差率
+        for (int length = 0; length <= SEGMENT_LENGTH; ++length)
+            smoothDecay[length] = static_cast<float>(std::pow(1.0 - static_cast<double>(SMOOTH_RATE), length));
+
+        if (allocated)
+        {
+            writePos = 0;
+            buffer.setSize(writePos, size);
+            clear();
+        }
+        else if (sr != previousRate)
+        {
+            const double scale = sr / previousRate;
+            buffer.changeRate(writePos, maxDelaySamples, 1.0 / scale, size);
+            quietSamples = std::min(static_cast<int>(quietSamples * scale), maxDelaySamples);
+            for (int i = 0; i < NUM_TAPS; ++i)
+                tapTimer[i] = static_cast<int>(tapTimer[i] * scale);
+        }
+    }
+
+    // 消失パターンの乱数シード。設定すると消失スケジュールと揺らぎをシードの初期状態からやり直す
+    // （確保なし、オーディオスレッドから呼べる）
+    void setSeed(std::uint32_t newSeed)
+    {
+        seed = newSeed;
+        restartSchedule();
+    }
+
+    std::uint32_t getSeed() const { return seed; }
+
+    // タップ読み出しの補間カーネル（次のブロックから反映）
+    void setInterpolation(InterpolationQuality newQuality) { interpolation = newQuality; }
+
+    // glideSamples > 0 ならディレイタイムはその長さをかけて線形に動かす（コントロールレートで
+    // 呼ばれても読み出し位置が段差なく進むように）。0 なら即座に切り替える
+    void setParameters(float delayTimeMs, float feedback, float vanishRate,
+                       float degradeAmount, float driftAmount, float detuneAmount, int glideSamples = 0)
+    {
+        glideRemaining = delayTimeMs != this->delayTimeMs ? glideSamples : 0;
+        if (glideRemaining > 0)
+        {
+            glideTargetMs = delayTimeMs;
+            glideStepMs = (delayTimeMs - this->delayTimeMs) / static_cast<float>(glideSamples);
+        }
+        else
+            this->delayTimeMs = delayTimeMs;
+        this->feedback = feedback;
+        this->vanishRate = vanishRate;
+        this->degradeAmount = degradeAmount;
+        this->driftAmount = driftAmount;
+        this->detuneAmount = detuneAmount;
+    }
+
+    float process(float input, float envelope = 0.0f)
+    {
+        float output;
+        process(&input, &envelope, &output, 1);
+        return output;
+    }
+
+    // ブロック処理（フィードバックを含むのでサンプル単位、in == out 可）
+    // 消失/復帰イベントとゲインランプはセグメント単位（最大 SEGMENT_LENGTH サンプル、
+    // 次のイベントで区切る）で決め、LFOもセグメントごとにまとめて生成する。
+    // セグメントは呼び出しをまたいで続くので、ブロックの切り方によらず同じ出力になる
+    void process(const float* input, const float* envelope, float* output, int numSamples)
+    {
+        FractionalDelay::dispatch(interpolation, [&](auto kernel)
+        {
+            processSegments<decltype(kernel)>(input, envelope, output, numSamples);
+        });
+    }
+
+    // バッファと状態を消去し、消失スケジュールもシードの初期状態に戻す（同じシードなら同じ出力になる）
+    void clear()
+    {
+        DelayMemoryArena::clear(&buffer, 1);
+        for (int i = 0; i < NUM_TAPS; ++i)
+            degradeLPState[i] = 0.0f;
+        fbLPState = 0.0f;
+        prevOutput = 0.0f;
+        quietSamples = maxDelaySamples;
+        restartSchedule();
+    }
+
+    // バッファに SILENCE_LEVEL を超える値が残っていないか。ディレイタイムは後から伸ばせるので、
+    // 最後に大きな値を書いてからバッファ全体（最大3秒）を書き進めたところで無音とする
+    bool isSilent() const { return quietSamples >= maxDelaySamples; }
+
+    // タップの現在ゲイン（表示用）
+    float getTapGain(int tap) const { return tapGainCurrent[tap]; }
+
+private:
+    // LFOバンクの割り当て: タイムドリフト4本 + デチューン4本
+    static constexpr int DRIFT_LFO = 0;
+    static constexpr int DETUNE_LFO = NUM_TAPS;
+    static constexpr int NUM_LFOS = NUM_TAPS * 2;
+
+    static constexpr double MAX_DELAY_SECONDS = 3.0;
+
+    // イベント判定とゲインランプの最大区間（LFOの補間区間に合わせる）
+    static constexpr int SEGMENT_LENGTH = LfoBank<NUM_LFOS>::CONTROL_INTERVAL;
+    // タップゲインのスムージング係数（時定数 約3300サンプル、バイオリンの音はブツ切り厳禁）
+    static constexpr float SMOOTH_RATE = 0.0003f;
+
+    template <typename Kernel>
+    void processSegments(const float* input, const float* envelope, float* output, int numSamples)
+    {
+        alignas(16) float lfo[SEGMENT_LENGTH * NUM_LFOS];
+        for (int start = 0; start < numSamples;)
+        {
+            if (segmentRemaining == 0)
+                beginSegment(envelope[start]);
+
+            const int len = std::min(segmentRemaining, numSamples - start);
+            renderModulation(lfo, len);
+            for (int i = 0; i < len; ++i)
+                output[start + i] = processSample<Kernel>(input[start + i], lfo + i * NUM_LFOS);
+
+            segmentRemaining -= len;
+            start += len;
+            if (segmentRemaining == 0)
+                std::copy(tapGainEnd, tapGainEnd + NUM_TAPS, tapGainCurrent); // 端点は正確な値に揃える
+        }
+    }
+
+    void restartSchedule()
+    {
+        rng.seed(seed);
+        float lfoPhases[NUM_LFOS];
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            tapGainTarget[i] = 1.0f;
+            tapGainCurrent[i] = 1.0f;
+            tapGainEnd[i] = 1.0f;
+            tapGainStep[i] = 0.0f;
+            tapTimer[i] = 0;
+            lfoPhases[DRIFT_LFO + i] = static_cast<float>(i) * 0.25f;
+            // 各タップにわずかなデチューン（合唱効果）
+            lfoPhases[DETUNE_LFO + i] = static_cast<float>(i) * 0.17f;
+        }
+        lfoBank.reset(lfoPhases);
+        segmentRemaining = 0;
+    }
+
+    // セグメント先頭: 期限の来たタップの消失/復帰を決め、次のイベントまでの長さと各タップのゲインランプを決める
+    void beginSegment(float envelope)
+    {
+        int length = SEGMENT_LENGTH;
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            if (tapTimer[i] <= 0)
+                triggerTapEvent(i, envelope);
+            length = std::min(length, tapTimer[i]);
+        }
+
+        // 1次スムージングの L サンプル後の値を閉形式で求め、区間内は線形に進める
+        const float invLength = 1.0f / static_cast<float>(length);
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            tapTimer[i] -= length;
+            tapGainEnd[i] = tapGainTarget[i] + (tapGainCurrent[i] - tapGainTarget[i]) * smoothDecay[length];
+            tapGainStep[i] = (tapGainEnd[i] - tapGainCurrent[i]) * invLength;
+        }
+        segmentRemaining = length;
+    }
+
+    // ランダム消失（エンベロープ依存: 弱く弾くと消えやすい）
+    void triggerTapEvent(int i, float envelope)
+    {
+        const float roll = rng.nextFloat();
+
+        // 弱音時は消失しやすく、強音時は生き残りやすい
+        const float effectiveVanishRate = vanishRate * (1.0f - envelope * 0.6f);
+
+        if (roll < effectiveVanishRate)
+        {
+            // フェードアウトで消える（バイオリンらしい滑らかさ）
+            tapGainTarget[i] = 0.0f;
+        }
+        else
+        {
+            // 戻る時もフェードイン
+            tapGainTarget[i] = rng.nextFloat() * 0.5f + 0.3f;
+        }
+
+        // 次の切り替えタイミング（バイオリンのテンポ感に合わせて長め）
+        tapTimer[i] = rng.nextInt(static_cast<int>(sr * 0.1), static_cast<int>(sr * 0.8));
+    }
+
+    void renderModulation(float* lfo, int numSamples)
+    {
+        const float fs = static_cast<float>(sr);
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            lfoBank.setIncrement(DRIFT_LFO + i, driftAmount * 0.07f / fs);
+            lfoBank.setIncrement(DETUNE_LFO + i, detuneAmount * 0.5f / fs);
+        }
+        lfoBank.render(lfo, nullptr, numSamples);
+    }
+
+    // lfo: このサンプルのLFO値（sin、NUM_LFOS 本）
+    template <typename Kernel>
+    float processSample(float input, const float* lfo)
+    {
+        if (glideRemaining > 0)
+            delayTimeMs = --glideRemaining > 0 ? delayTimeMs + glideStepMs : glideTargetMs;
+
+        // 4タップの間隔 — 5度と4度の音程関係をモチーフにした比率
+        const float tapRatios[NUM_TAPS] = { 1.0f, 0.667f, 0.5f, 0.333f };
+        // 読み出しが書き込み位置を追い越さない最短の遅延と、バッファに収まる最長の遅延
+        const float minDelay = static_cast<float>(Kernel::TAPS - Kernel::FIRST - 1);
+        const float maxDelay = static_cast<float>(maxDelaySamples - FractionalDelay::MAX_TAPS);
+
+        // 4タップの読み出し位置を決め、タップをレーンに並べてまとめて補間する
+        const float* taps[NUM_TAPS];
+        alignas(16) float frac[NUM_TAPS];
+        alignas(16) float tapOuts[NUM_TAPS];
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            // タイムドリフト + デチューン
+            float drift = lfo[DRIFT_LFO + i] * driftAmount * (static_cast<float>(sr) / 1000.0f);
+
+            // 微細ピッチデチューン（コーラス効果 — 弦楽器的な揺らぎ）
+            float detune = lfo[DETUNE_LFO + i] * detuneAmount * 0.3f * (static_cast<float>(sr) / 1000.0f);
+
+            float delaySamples = delayTimeMs * tapRatios[i]
+                               * (static_cast<float>(sr) / 1000.0f) + drift + detune;
+            delaySamples = std::clamp(delaySamples, minDelay, maxDelay);
+
+            // 位置 writePos - delaySamples = (writePos - whole - 1) + frac
+            const int whole = static_cast<int>(delaySamples);
+            frac[i] = 1.0f - (delaySamples - static_cast<float>(whole));
+            taps[i] = buffer.tap(writePos - whole - 1 - Kernel::FIRST);
+        }
+        FractionalDelay::interpolateLanes<Kernel, NUM_TAPS>(taps, frac, tapOuts);
+
+        float output = 0.0f;
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            tapGainCurrent[i] += tapGainStep[i];
+            float tapOut = tapOuts[i];
+
+            // かすれエフェクト: ソフトなローパス劣化（バイオリンなのでビットクラッシュは使わない）
+            float lpCoeff = 1.0f - degradeAmount * 0.85f;
+            degradeLPState[i] = tapOut * (1.0f - lpCoeff) + degradeLPState[i] * lpCoeff;
+
+            // 劣化量に応じてLP出力とドライをブレンド
+            tapOut = tapOut * (1.0f - degradeAmount * 0.7f)
+                   + degradeLPState[i] * degradeAmount * 0.7f;
+
+            output += tapOut * tapGainCurrent[i];
+        }
+
+        output /= static_cast<float>(NUM_TAPS);
+
+        // フィードバック（高域を少し落としてフィードバックが濁らないように）
+        float fbSignal = output * feedback;
+        fbLPState = fbSignal * 0.3f + fbLPState * 0.7f;
+
+        const float written = input + fbLPState;
+        buffer.write(writePos, written);
+        writePos = (writePos + 1) & buffer.mask;
+        quietSamples = std::abs(written) > SILENCE_LEVEL ? 0 : std::min(quietSamples + 1, maxDelaySamples);
+
+        prevOutput = output;
+        return output;
+    }
+
+    double sr = 48000.0;
+    double capacityRate = 0.0; // バッファを確保したレート（これまでの最大）
+    DelayMemoryArena arena;
+    DelayMemoryArena::Line buffer;
+    int maxDelaySamples = 0;
+    int writePos = 0;
+    int quietSamples = 0;   // SILENCE_LEVEL 以下の書き込みが続いたサンプル数（maxDelaySamples で頭打ち）
+
+    float delayTimeMs = 500.0f;
+    float glideTargetMs = 500.0f, glideStepMs = 0.0f; // ディレイタイムの線形の移動（setParameters）
+    int glideRemaining = 0;
+    float feedback = 0.5f;
+    float vanishRate = 0.3f;
+    float degradeAmount = 0.3f;
+    float driftAmount = 2.0f;
+    float detuneAmount = 1.0f;
+
+    float tapGainTarget[NUM_TAPS] = {};
+    float tapGainCurrent[NUM_TAPS] = {};
+    float tapGainEnd[NUM_TAPS] = {};
+    float tapGainStep[NUM_TAPS] = {};
+    float smoothDecay[SEGMENT_LENGTH + 1] = {};
+    int segmentRemaining = 0;
+    int tapTimer[NUM_TAPS] = {};
+    float degradeLPState[NUM_TAPS] = {};
+
+    float fbLPState = 0.0f;
+    float prevOutput = 0.0f;
+
+    LfoBank<NUM_LFOS> lfoBank;
+    FastRandom rng;
+    std::uint32_t seed = 42;
+    InterpolationQuality interpolation = InterpolationQuality::hermite;
+};
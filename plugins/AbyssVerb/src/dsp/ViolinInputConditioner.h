@@ -0,0 +1,200 @@
+#pragma once
+#include "DspCommon.h"
+#include "DspKernels.h"
+#include <cmath>
+#include <algorithm>
+
+//==============================================================================
+// ピエゾEQ / インプットコンディショナー
+// ピエゾ特有の1-3kHzのギスギスを除去 + ボディレゾナンス付加
+//==============================================================================
+class ViolinInputConditioner
+{
+public:
+    // 係数の再計算はコントロールレート（このサンプル数ごと）に間引く
+    static constexpr int CONTROL_INTERVAL = 16;
+
+    void prepare(double sampleRate)
+    {
+        sr = sampleRate;
+        kernels = &SimdDispatch::select();
+        // ピエゾ補正用ノッチ (2kHz付近)
+        calcNotchCoeffs(2200.0, 2.5);
+        // ボディレゾナンス用ピーク (440Hz付近、バイオリンの主要共鳴)
+        calcResonanceCoeffs(440.0, 3.0, 2.0);
+        // ハイシェルフ (明るさ制御)
+        calcHighShelfCoeffs(4000.0, 0.0);
+
+        // 上の係数に対応するパラメーター値
+        appliedNotchDepth = targetNotchDepth = 1.0f;
+        appliedBodyResonance = targetBodyResonance = 0.5f;
+        appliedBrightness = targetBrightness = 0.5f;
+        coeffsDirty = false;
+        controlCountdown = 0;
+
+        // 状態リセット
+        for (int i = 0; i < 3; ++i)
+        {
+            notchZ1[i] = notchZ2[i] = 0.0f;
+            resZ1[i] = resZ2[i] = 0.0f;
+            hsZ1[i] = hsZ2[i] = 0.0f;
+        }
+    }
+
+    // 目標値を記録するだけ。係数は値が実際に動いた時のみ、
+    // 次のコントロール境界で再計算される（サンプルごとに呼んでも軽い）
+    void setParameters(float notchDepth, float bodyResonance, float brightness)
+    {
+        targetNotchDepth = notchDepth;
+        targetBodyResonance = bodyResonance;
+        targetBrightness = brightness;
+
+        coeffsDirty = std::abs(targetNotchDepth - appliedNotchDepth) > PARAM_EPSILON
+                   || std::abs(targetBodyResonance - appliedBodyResonance) > PARAM_EPSILON
+                   || std::abs(targetBrightness - appliedBrightness) > PARAM_EPSILON;
+    }
+
+    // 命令セット別カーネルの表を差し替える（prepare は SimdDispatch::select() の表を使う。ベンチマーク用）
+    void setKernels(const DspKernels& newKernels) { kernels = &newKernels; }
+
+    float process(float input)
+    {
+        if (controlCountdown <= 0)
+            updateControl();
+        --controlCountdown;
+
+        float x = input;
+        // ノッチフィルタ（ピエゾ補正）
+        x = biquadProcess(x, notchB, notchA, notchZ1, notchZ2);
+        // ボディレゾナンス
+        x = biquadProcess(x, resB, resA, resZ1, resZ2);
+        // ハイシェルフ
+        x = biquadProcess(x, hsB, hsA, hsZ1, hsZ2);
+        return x;
+    }
+
+    // ブロック処理: コントロール区間ごとに係数を確定させ、
+    // 区間内は3段を直列にしたカーネルで1サンプルずつ全段に通す (in == out 可)
+    void process(const float* input, float* output, int numSamples)
+    {
+        int pos = 0;
+        while (pos < numSamples)
+        {
+            if (controlCountdown <= 0)
+                updateControl();
+
+            const int todo = std::min(numSamples - pos, controlCountdown);
+            const DspKernels::BiquadSection sections[] = {
+                { notchB, notchA, &notchZ1[0], &notchZ2[0] },   // ノッチフィルタ（ピエゾ補正）
+                { resB, resA, &resZ1[0], &resZ2[0] },           // ボディレゾナンス
+                { hsB, hsA, &hsZ1[0], &hsZ2[0] }                // ハイシェルフ
+            };
+            kernels->biquadCascade(input + pos, output + pos, todo, sections, 3);
+
+            controlCountdown -= todo;
+            pos += todo;
+        }
+    }
+
+private:
+    double sr = 48000.0;
+    const DspKernels* kernels = &SimdDispatch::baseline();
+
+    // Biquad係数 [b0, b1, b2] / [a0(=1), a1, a2]
+    float notchB[3] = {}, notchA[3] = {};
+    float resB[3] = {}, resA[3] = {};
+    float hsB[3] = {}, hsA[3] = {};
+
+    // Biquad状態
+    float notchZ1[3] = {}, notchZ2[3] = {};
+    float resZ1[3] = {}, resZ2[3] = {};
+    float hsZ1[3] = {}, hsZ2[3] = {};
+
+    // コントロールレート更新
+    static constexpr float PARAM_EPSILON = 1.0e-4f;
+    float targetNotchDepth = 1.0f, targetBodyResonance = 0.5f, targetBrightness = 0.5f;
+    float appliedNotchDepth = 1.0f, appliedBodyResonance = 0.5f, appliedBrightness = 0.5f;
+    bool coeffsDirty = false;
+    int controlCountdown = 0;
+
+    void updateControl()
+    {
+        controlCountdown = CONTROL_INTERVAL;
+        if (! coeffsDirty)
+            return;
+
+        // notchDepth: 0=補正なし, 1=フル補正
+        calcNotchCoeffs(2200.0, 2.5 * targetNotchDepth);
+        // bodyResonance: 0=なし, 1=豊かなボディ感
+        calcResonanceCoeffs(440.0, 3.0, targetBodyResonance * 4.0);
+        // brightness: -6 ~ +6 dB
+        calcHighShelfCoeffs(4000.0, (targetBrightness - 0.5f) * 12.0f);
+
+        appliedNotchDepth = targetNotchDepth;
+        appliedBodyResonance = targetBodyResonance;
+        appliedBrightness = targetBrightness;
+        coeffsDirty = false;
+    }
+
+    float biquadProcess(float x, const float b[3], const float a[3],
+                        float z1[3], float z2[3])
+    {
+        float y = b[0] * x + z1[0];
+        z1[0] = b[1] * x - a[1] * y + z2[0];
+        z2[0] = b[2] * x - a[2] * y;
+        return y;
+    }
+
+    void calcNotchCoeffs(double freq, double Q)
+    {
+        if (Q < 0.01) { notchB[0]=1; notchB[1]=0; notchB[2]=0;
+                         notchA[0]=1; notchA[1]=0; notchA[2]=0; return; }
+        double w0 = 2.0 * DspConstants<double>::pi * freq / sr;
+        double alpha = std::sin(w0) / (2.0 * Q);
+        double a0 = 1.0 + alpha;
+        notchB[0] = static_cast<float>(1.0 / a0);
+        notchB[1] = static_cast<float>(-2.0 * std::cos(w0) / a0);
+        notchB[2] = static_cast<float>(1.0 / a0);
+        notchA[0] = 1.0f;
+        notchA[1] = static_cast<float>(-2.0 * std::cos(w0) / a0);
+        notchA[2] = static_cast<float>((1.0 - alpha) / a0);
+    }
+
+    void calcResonanceCoeffs(double freq, double Q, double gainDB)
+    {
+        if (gainDB < 0.01 && gainDB > -0.01) {
+            resB[0]=1; resB[1]=0; resB[2]=0;
+            resA[0]=1; resA[1]=0; resA[2]=0; return;
+        }
+        double A = std::pow(10.0, gainDB / 40.0);
+        double w0 = 2.0 * DspConstants<double>::pi * freq / sr;
+        double alpha = std::sin(w0) / (2.0 * Q);
+        double a0 = 1.0 + alpha / A;
+        resB[0] = static_cast<float>((1.0 + alpha * A) / a0);
+        resB[1] = static_cast<float>((-2.0 * std::cos(w0)) / a0);
+        resB[2] = static_cast<float>((1.0 - alpha * A) / a0);
+        resA[0] = 1.0f;
+        resA[1] = static_cast<float>((-2.0 * std::cos(w0)) / a0);
+        resA[2] = static_cast<float>((1.0 - alpha / A) / a0);
+    }
+
+    void calcHighShelfCoeffs(double freq, double gainDB)
+    {
+        if (gainDB < 0.01 && gainDB > -0.01) {
+            hsB[0]=1; hsB[1]=0; hsB[2]=0;
+            hsA[0]=1; hsA[1]=0; hsA[2]=0; return;
+        }
+        double A = std::pow(10.0, gainDB / 40.0);
+        double w0 = 2.0 * DspConstants<double>::pi * freq / sr;
+        double cosw0 = std::cos(w0);
+        double alpha = std::sin(w0) / 2.0 * std::sqrt(2.0);
+        double sqrtA2alpha = 2.0 * std::sqrt(A) * alpha;
+        double a0 = (A+1) - (A-1)*cosw0 + sqrtA2alpha;
+        hsB[0] = static_cast<float>(A*((A+1) + (A-1)*cosw0 + sqrtA2alpha) / a0);
+        hsB[1] = static_cast<float>(-2.0*A*((A-1) + (A+1)*cosw0) / a0);
+        hsB[2] = static_cast<float>(A*((A+1) + (A-1)*cosw0 - sqrtA2alpha) / a0);
+        hsA[0] = 1.0f;
+        hsA[1] = static_cast<float>(2.0*((A-1) - (A+1)*cosw0) / a0);
+        hsA[2] = static_cast<float>(((A+1) - (A-1)*cosw0 - sqrtA2alpha) / a0);
+    }
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "AbyssFDNReverb.h"
+#include "VanishingDelay.h"
+#include "SpscQueue.h"
+#include <algorithm>
+#include <array>
+
+//==============================================================================
+// 表示用のエンジン状態 — FRAME_RATE ごとに1つ、オーディオスレッドからエディターへ渡す
+//==============================================================================
+struct VisualizerFrame
+{
+    static constexpr int NUM_LINES = AbyssFDNReverb::NUM_LINES;
+    static constexpr int NUM_TAPS = VanishingDelay::NUM_TAPS;
+
+    // 深淵リバーブの各ラインのエネルギー（直近の平均二乗。鳴っているネットワークを
+    // トゥルーステレオのクロスフェード比で合算）
+    std::array<float, NUM_LINES> lineEnergy {};
+    // 消失ディレイの各タップの現在ゲイン（0 = 消えた, 1 = 鳴っている。L/R）
+    std::array<std::array<float, NUM_TAPS>, 2> tapGain {};
+    // 弓圧エンベロープ（L/R）
+    std::array<float, 2> envelope {};
+    bool sleeping = false;
+};
+
+//==============================================================================
+// 表示フィード — 間引いたフレームをロックなしのリングでエディターへ送る
+// オーディオスレッドは process ごとに isDue で間隔を数え、期限が来た時だけフレームを作って
+// publish する（確保・ロックなし）。エディターが止まってリングが満杯の間はフレームを作らずに捨て、
+// 読み出し側は溜まった分をまとめて読んで最新のものを表示すればよい
+//==============================================================================
+class VisualizerFeed
+{
+public:
+    static constexpr double FRAME_RATE = 120.0; // エディターの描画（30〜60fps）より細かく
+    static constexpr int QUEUE_SIZE = 64;       // 約0.5秒分
+
+    void prepare(double sampleRate)
+    {
+        interval = std::max(1, static_cast<int>(sampleRate / FRAME_RATE));
+        elapsed = 0;
+    }
+
+    // オーディオスレッド: numSamples 進めて、フレームを出す時期で、受け取る余地があれば true
+    bool isDue(int numSamples)
+    {
+        elapsed += numSamples;
+        if (elapsed < interval)
+            return false;
+
+        elapsed = 0;
+        return queue.size() < QUEUE_SIZE;
+    }
+
+    void publish(const VisualizerFrame& frame) { queue.push(frame); }
+
+    // 1つの非オーディオスレッドから
+    bool pop(VisualizerFrame& frame) { return queue.pop(frame); }
+    void discard() { queue.discard(); }
+
+private:
+    SpscQueue<VisualizerFrame, QUEUE_SIZE> queue;
+    int interval = 400;
+    int elapsed = 0;
+};
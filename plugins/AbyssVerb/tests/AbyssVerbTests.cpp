@@ -0,0 +1,561 @@
+//==============================================================================
+// AbyssVerbTests — DSPコアのテスト（JUCE 非依存、ctest から実行）
+//
+//   AbyssVerbTests <テスト名>   1つを実行（ctest はテストごとにこの形で呼ぶ）
+//   AbyssVerbTests              全部を実行
+//   AbyssVerbTests --update-golden   golden の参照（tests/golden）を作り直す
+// 失敗したら理由を標準エラーに出して 1 を返す
+//==============================================================================
+#include "dsp/AbyssVerbEngine.h"
+#include "dsp/FastRandom.h"
+#include "dsp/GoldenCases.h"
+#include "dsp/RealFft.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct TestCase
+{
+    const char* name;
+    bool (*run)();
+};
+
+//==============================================================================
+// FDN: SIMD カーネル版の process と スカラー参照の processReference の比較
+//
+// 許容誤差 FDN_REFERENCE_TOLERANCE は出力の絶対誤差（入力ピーク 0.5 に対して）。
+// カーネルは FMA 縮約なしでビルドしているので x86 では全版がビット単位で一致する（誤差 0）。
+// 縮約が入りうるビルド（NEON の既定など）でも丸めの違いはフィードバックで増えずに
+// 減衰するので、float の分解能の数倍に収まる
+//==============================================================================
+constexpr float FDN_REFERENCE_TOLERANCE = 1.0e-5f;
+
+bool fdnMatchesReference()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 96000; // 2秒（前半に入力、後半はテールだけ）
+
+    // 入力は帯域の広いノイズのバースト、弓圧はゆっくり動かして変調の深さも変える
+    std::vector<float> input(numSamples), envelope(numSamples);
+    FastRandom random(1234);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        input[static_cast<size_t>(i)] = i < numSamples / 2 ? random.nextFloat() - 0.5f : 0.0f;
+        envelope[static_cast<size_t>(i)] = 0.5f + 0.5f * std::sin(static_cast<float>(i) * 0.0005f);
+    }
+
+    bool passed = true;
+    for (auto variant : { SimdVariant::scalar, SimdVariant::sse2, SimdVariant::neon,
+                          SimdVariant::avx2, SimdVariant::avx512 })
+    {
+        if (! SimdDispatch::isAvailable(variant))
+            continue;
+
+        for (auto quality : { InterpolationQuality::linear, InterpolationQuality::hermite,
+                              InterpolationQuality::lagrange, InterpolationQuality::sinc })
+        {
+            auto simd = std::make_unique<AbyssFDNReverb>();
+            auto reference = std::make_unique<AbyssFDNReverb>();
+            for (auto* fdn : { simd.get(), reference.get() })
+            {
+                fdn->prepare(sampleRate, 512);
+                fdn->setKernels(SimdDispatch::get(variant));
+                fdn->setInterpolation(quality);
+                fdn->clear();
+            }
+
+            float maxError = 0.0f;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                // 途中で減衰時間とダンピングを変え、ゲインテーブルのランプも通す
+                const float decay = i < numSamples / 4 ? 8.0f : 3.0f;
+                const float dampHigh = i < numSamples / 3 ? 0.65f : 0.4f;
+                for (auto* fdn : { simd.get(), reference.get() })
+                {
+                    fdn->setParameters(decay, dampHigh, 0.3f, 1.5f, 0.4f);
+                    fdn->setDecayShelf(1.5f, 0.6f, 1500.0f);
+                }
+
+                const auto n = static_cast<size_t>(i);
+                const float a = simd->process(input[n], envelope[n]);
+                const float b = reference->processReference(input[n], envelope[n]);
+                maxError = std::max(maxError, std::abs(a - b));
+            }
+
+            if (maxError > FDN_REFERENCE_TOLERANCE)
+            {
+                std::fprintf(stderr, "fdn-reference: %s / %s: max error %.3g exceeds %.3g\n",
+                             SimdDispatch::variantName(variant), FractionalDelay::qualityName(quality),
+                             maxError, FDN_REFERENCE_TOLERANCE);
+                passed = false;
+            }
+            else
+                std::printf("fdn-reference: %-7s %-8s max error %.3g\n", SimdDispatch::variantName(variant),
+                            FractionalDelay::qualityName(quality), maxError);
+        }
+    }
+    return passed;
+}
+
+//==============================================================================
+// ソフトリミッター: 命令セット別の softClip カーネルと OutputStage::softClipReference の比較
+//
+// OutputStage.h に書いた精度を確かめる（|x| <= 60 を 1e-4 刻みで走査）: 曲線の絶対誤差が
+// SOFT_CLIP_TOLERANCE（1 付近の float 2 ulp、実測 6e-8）以内、出力は ±1 以内、
+// |x| <= SOFT_CLIP_KNEE は入力がビット単位でそのまま通る
+//==============================================================================
+constexpr float SOFT_CLIP_TOLERANCE = 2.4e-7f;
+
+bool softClipMatchesReference()
+{
+    std::vector<float> input;
+    for (int i = -600000; i <= 600000; ++i)
+        input.push_back(static_cast<float>(i) * 1.0e-4f);
+
+    bool passed = true;
+    for (auto variant : { SimdVariant::scalar, SimdVariant::sse2, SimdVariant::neon,
+                          SimdVariant::avx2, SimdVariant::avx512 })
+    {
+        if (! SimdDispatch::isAvailable(variant))
+            continue;
+
+        auto output = input;
+        SimdDispatch::get(variant).softClip(output.data(), static_cast<int>(output.size()));
+
+        float maxError = 0.0f, maxOutput = 0.0f;
+        size_t changedBelowKnee = 0;
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            maxError = std::max(maxError, std::abs(output[i] - OutputStage::softClipReference(input[i])));
+            maxOutput = std::max(maxOutput, std::abs(output[i]));
+            if (std::abs(input[i]) <= OutputStage::SOFT_CLIP_KNEE && output[i] != input[i])
+                ++changedBelowKnee;
+        }
+
+        if (maxError > SOFT_CLIP_TOLERANCE || maxOutput > 1.0f || changedBelowKnee > 0)
+        {
+            std::fprintf(stderr, "soft-clip: %s: max error %.3g (tolerance %.3g), max output %.9g, "
+                                 "%zu samples below the knee changed\n",
+                         SimdDispatch::variantName(variant), maxError, SOFT_CLIP_TOLERANCE, maxOutput,
+                         changedBelowKnee);
+            passed = false;
+        }
+        else
+            std::printf("soft-clip: %-7s max error %.3g\n", SimdDispatch::variantName(variant), maxError);
+    }
+    return passed;
+}
+
+//==============================================================================
+// ゴールデン: dsp/GoldenCases.h のケースをレンダーし、コミット済みの参照とサンプル単位で比較
+//
+// 参照は2つ（tests/golden/<ケース名>.*）:
+//   .wav        GOLDEN_DECIMATION 分の1に間引いた波形（float32 ステレオ、通過域 GOLDEN_PASSBAND_HZ まで）
+//   .bands.txt  間引きで落ちる帯域のスペクトル概要（GOLDEN_WINDOW_SECONDS ごとの L/R の帯域レベル）
+// 波形は差分信号で比べる: 差分の RMS（参照の RMS に対する dB）と差分のピーク（dBFS）。
+// 極性の反転、L/R の入れ替え、サンプルのずれ、位相や音色の変化は差分に丸ごと出る。
+//
+// 許容誤差は丸めの違いの実測から決めた。x86-64 / GCC 12 で -O0 と命令セット別カーネルなしのビルドは参照と
+// ビット単位で一致し、FMA 縮約（-march=native または -mfma に -ffp-contract=fast）で最大
+// 差分 RMS -100.0 dB / 差分ピーク -104.6 dBFS / 帯域レベル 0.011 dB（高域のほぼ無音の窓）。
+// libm の違い（MSVC、Apple）も同じく末尾ビットの違いなので、波形に 20 dB、帯域に 10 倍の余裕を取った。
+// 1 サンプルのずれは 1 kHz で -18 dB、0.01 dB のゲインの違いは -59 dB の差分になるので十分に拾える。
+// 音を意図して変えた時は --update-golden で作り直し、変化を説明したコミットで参照も更新する
+//==============================================================================
+constexpr int GOLDEN_DECIMATION = 8;
+constexpr double GOLDEN_PASSBAND_HZ = 2400.0;
+constexpr int GOLDEN_FILTER_HALF_LENGTH = 16 * GOLDEN_DECIMATION; // 間引きフィルターの片側のタップ数
+constexpr double GOLDEN_FILTER_KAISER_BETA = 10.0;                 // 阻止域 約 -100 dB
+constexpr double GOLDEN_WINDOW_SECONDS = 0.02;
+constexpr int GOLDEN_FFT_SIZE = 1024;
+constexpr double GOLDEN_BAND_EDGES_HZ[] = { 2400.0, 3400.0, 4800.0, 6800.0, 9600.0, 13600.0, 24000.0 };
+constexpr int GOLDEN_NUM_BANDS = static_cast<int>(sizeof(GOLDEN_BAND_EDGES_HZ) / sizeof(GOLDEN_BAND_EDGES_HZ[0])) - 1;
+
+constexpr double GOLDEN_DIFF_RMS_TOLERANCE_DB = -80.0;
+constexpr double GOLDEN_DIFF_PEAK_TOLERANCE_DB = -85.0;
+constexpr double GOLDEN_BAND_TOLERANCE_DB = 0.1;
+
+#ifndef ABYSSVERB_GOLDEN_DIR
+ #define ABYSSVERB_GOLDEN_DIR "tests/golden"
+#endif
+
+struct GoldenSummary
+{
+    GoldenRender waveform;                                  // 間引いた波形
+    std::vector<std::array<float, 2 * GOLDEN_NUM_BANDS>> bands; // 窓ごとの L の帯域、R の帯域（dB）
+};
+
+// カイザー窓の windowed-sinc で帯域制限してから間引く（係数と積和は double）
+std::vector<float> goldenDecimate(const std::vector<float>& samples)
+{
+    constexpr double pi = DspConstants<double>::pi;
+    constexpr int half = GOLDEN_FILTER_HALF_LENGTH;
+    const double cutoff = (GOLDEN_PASSBAND_HZ + 0.5 * GOLDEN_SAMPLE_RATE / GOLDEN_DECIMATION) * 0.5 / GOLDEN_SAMPLE_RATE;
+
+    std::vector<double> taps(2 * half + 1);
+    for (int k = -half; k <= half; ++k)
+    {
+        const double r = static_cast<double>(k) / half;
+        const double sinc = k == 0 ? 2.0 * cutoff : std::sin(2.0 * pi * cutoff * k) / (pi * k);
+        taps[static_cast<size_t>(k + half)] = sinc * besselI0(GOLDEN_FILTER_KAISER_BETA * std::sqrt(1.0 - r * r))
+                                            / besselI0(GOLDEN_FILTER_KAISER_BETA);
+    }
+
+    const auto length = static_cast<long>(samples.size());
+    std::vector<float> out;
+    for (long centre = 0; centre < length; centre += GOLDEN_DECIMATION)
+    {
+        double sum = 0.0;
+        for (long k = std::max(-static_cast<long>(half), -centre); k <= half && centre + k < length; ++k)
+            sum += taps[static_cast<size_t>(k + half)] * samples[static_cast<size_t>(centre + k)];
+        out.push_back(static_cast<float>(sum));
+    }
+    return out;
+}
+
+// ハン窓の FFT で帯域ごとの平均二乗を dB にする（SILENCE_LEVEL 未満は SILENCE_LEVEL として扱う）
+std::array<float, GOLDEN_NUM_BANDS> goldenBandLevels(const float* samples, int length, const RealFft& fft)
+{
+    constexpr double pi = DspConstants<double>::pi;
+    std::vector<float> windowed(GOLDEN_FFT_SIZE, 0.0f), re(GOLDEN_FFT_SIZE / 2), im(GOLDEN_FFT_SIZE / 2);
+    double windowEnergy = 0.0;
+    for (int i = 0; i < length; ++i)
+    {
+        const double w = 0.5 - 0.5 * std::cos(2.0 * pi * (i + 0.5) / length);
+        windowed[static_cast<size_t>(i)] = static_cast<float>(w * samples[i]);
+        windowEnergy += w * w;
+    }
+    fft.forward(windowed.data(), re.data(), im.data());
+
+    std::array<float, GOLDEN_NUM_BANDS> levels {};
+    const double binHz = GOLDEN_SAMPLE_RATE / GOLDEN_FFT_SIZE;
+    for (int band = 0; band < GOLDEN_NUM_BANDS; ++band)
+    {
+        double energy = 0.0;
+        for (int bin = 1; bin < GOLDEN_FFT_SIZE / 2; ++bin)
+            if (bin * binHz >= GOLDEN_BAND_EDGES_HZ[band] && bin * binHz < GOLDEN_BAND_EDGES_HZ[band + 1])
+                energy += static_cast<double>(re[static_cast<size_t>(bin)]) * re[static_cast<size_t>(bin)]
+                        + static_cast<double>(im[static_cast<size_t>(bin)]) * im[static_cast<size_t>(bin)];
+        // パーセバルの定理で片側スペクトルから窓内の平均二乗に戻す
+        const double meanSquare = 2.0 * energy / (GOLDEN_FFT_SIZE * windowEnergy);
+        const double floor = static_cast<double>(SILENCE_LEVEL) * SILENCE_LEVEL;
+        levels[static_cast<size_t>(band)] = static_cast<float>(10.0 * std::log10(std::max(meanSquare, floor)));
+    }
+    return levels;
+}
+
+GoldenSummary summarizeGolden(const GoldenRender& render)
+{
+    GoldenSummary summary { { goldenDecimate(render.left), goldenDecimate(render.right) }, {} };
+
+    RealFft fft;
+    fft.setSize(GOLDEN_FFT_SIZE);
+    const auto window = static_cast<size_t>(GOLDEN_WINDOW_SECONDS * GOLDEN_SAMPLE_RATE);
+    for (size_t start = 0; start + window <= render.left.size(); start += window)
+    {
+        const auto left = goldenBandLevels(render.left.data() + start, static_cast<int>(window), fft);
+        const auto right = goldenBandLevels(render.right.data() + start, static_cast<int>(window), fft);
+        std::array<float, 2 * GOLDEN_NUM_BANDS> levels {};
+        std::copy(left.begin(), left.end(), levels.begin());
+        std::copy(right.begin(), right.end(), levels.begin() + GOLDEN_NUM_BANDS);
+        summary.bands.push_back(levels);
+    }
+    return summary;
+}
+
+std::string goldenPath(const GoldenCase& goldenCase, const char* extension)
+{
+    return std::string(ABYSSVERB_GOLDEN_DIR) + "/" + goldenCase.name + extension;
+}
+
+//------------------------------------------------------------------------------
+// 参照ファイル — WAV は float32 ステレオの最小限の RIFF（fmt と data のみ、リトルエンディアン前提）
+void putLe32(std::FILE* file, uint32_t value)
+{
+    const unsigned char bytes[] = { static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+                                    static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24) };
+    std::fwrite(bytes, 1, 4, file);
+}
+
+void putLe16(std::FILE* file, uint16_t value)
+{
+    const unsigned char bytes[] = { static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8) };
+    std::fwrite(bytes, 1, 2, file);
+}
+
+uint32_t getLe32(const unsigned char* bytes)
+{
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8
+         | static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+uint16_t getLe16(const unsigned char* bytes)
+{
+    return static_cast<uint16_t>(bytes[0] | bytes[1] << 8);
+}
+
+bool writeGoldenWav(const std::string& path, const GoldenRender& waveform)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const auto dataBytes = static_cast<uint32_t>(waveform.left.size() * 2 * sizeof(float));
+    const auto rate = static_cast<uint32_t>(GOLDEN_SAMPLE_RATE / GOLDEN_DECIMATION);
+    std::fwrite("RIFF", 1, 4, file);
+    putLe32(file, 36 + dataBytes);
+    std::fwrite("WAVEfmt ", 1, 8, file);
+    putLe32(file, 16);
+    putLe16(file, 3); // WAVE_FORMAT_IEEE_FLOAT
+    putLe16(file, 2);
+    putLe32(file, rate);
+    putLe32(file, rate * 2 * sizeof(float));
+    putLe16(file, 2 * sizeof(float));
+    putLe16(file, 32);
+    std::fwrite("data", 1, 4, file);
+    putLe32(file, dataBytes);
+    for (size_t i = 0; i < waveform.left.size(); ++i)
+    {
+        const float frame[] = { waveform.left[i], waveform.right[i] };
+        std::fwrite(frame, sizeof(float), 2, file);
+    }
+    return std::fclose(file) == 0;
+}
+
+bool readGoldenWav(const std::string& path, GoldenRender& waveform)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    unsigned char header[44];
+    const bool valid = std::fread(header, 1, sizeof(header), file) == sizeof(header)
+                    && std::memcmp(header, "RIFF", 4) == 0 && std::memcmp(header + 8, "WAVEfmt ", 8) == 0
+                    && getLe16(header + 20) == 3 && getLe16(header + 22) == 2 && getLe16(header + 34) == 32
+                    && getLe32(header + 24) == static_cast<uint32_t>(GOLDEN_SAMPLE_RATE / GOLDEN_DECIMATION)
+                    && std::memcmp(header + 36, "data", 4) == 0;
+    if (valid)
+    {
+        const size_t frames = getLe32(header + 40) / (2 * sizeof(float));
+        std::vector<float> interleaved(frames * 2);
+        if (std::fread(interleaved.data(), sizeof(float), interleaved.size(), file) == interleaved.size())
+            for (size_t i = 0; i < frames; ++i)
+            {
+                waveform.left.push_back(interleaved[i * 2]);
+                waveform.right.push_back(interleaved[i * 2 + 1]);
+            }
+    }
+    std::fclose(file);
+    return valid && ! waveform.left.empty();
+}
+
+bool writeGoldenBands(const std::string& path, const std::vector<std::array<float, 2 * GOLDEN_NUM_BANDS>>& bands)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "# window %g s, band level dB (left bands, then right bands), edges Hz:", GOLDEN_WINDOW_SECONDS);
+    for (const double edge : GOLDEN_BAND_EDGES_HZ)
+        std::fprintf(file, " %g", edge);
+    std::fprintf(file, "\n");
+    for (const auto& levels : bands)
+    {
+        for (size_t k = 0; k < levels.size(); ++k)
+            std::fprintf(file, k == 0 ? "%.6f" : " %.6f", static_cast<double>(levels[k]));
+        std::fprintf(file, "\n");
+    }
+    return std::fclose(file) == 0;
+}
+
+bool readGoldenBands(const std::string& path, std::vector<std::array<float, 2 * GOLDEN_NUM_BANDS>>& bands)
+{
+    std::FILE* file = std::fopen(path.c_str(), "r");
+    if (file == nullptr)
+        return false;
+
+    char line[512];
+    while (std::fgets(line, sizeof(line), file) != nullptr)
+    {
+        if (line[0] == '#')
+            continue;
+        std::array<float, 2 * GOLDEN_NUM_BANDS> levels {};
+        const char* cursor = line;
+        size_t count = 0;
+        for (int consumed = 0; count < levels.size() && std::sscanf(cursor, "%f%n", &levels[count], &consumed) == 1;
+             ++count)
+            cursor += consumed;
+        if (count == levels.size())
+            bands.push_back(levels);
+    }
+    std::fclose(file);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+double levelDb(double value)
+{
+    return 20.0 * std::log10(std::max(value, 1.0e-30));
+}
+
+// 1チャンネルの差分信号を比べる。報告用に差分 RMS（dB、参照比）と差分ピーク（dBFS）を返す
+bool goldenWaveformMatches(const std::vector<float>& rendered, const std::vector<float>& reference,
+                           double& diffRmsDb, double& diffPeakDb, size_t& peakIndex)
+{
+    double diffEnergy = 0.0, referenceEnergy = 0.0, diffPeak = 0.0;
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        const double diff = static_cast<double>(rendered[i]) - reference[i];
+        diffEnergy += diff * diff;
+        referenceEnergy += static_cast<double>(reference[i]) * reference[i];
+        if (std::abs(diff) > diffPeak)
+        {
+            diffPeak = std::abs(diff);
+            peakIndex = i;
+        }
+    }
+    diffRmsDb = levelDb(std::sqrt(diffEnergy / std::max(referenceEnergy, 1.0e-30)));
+    diffPeakDb = levelDb(diffPeak);
+    return diffRmsDb <= GOLDEN_DIFF_RMS_TOLERANCE_DB && diffPeakDb <= GOLDEN_DIFF_PEAK_TOLERANCE_DB;
+}
+
+bool goldenMatchesReference()
+{
+    bool passed = true;
+    for (const auto& goldenCase : goldenCases())
+    {
+        const auto summary = summarizeGolden(renderGoldenCase(goldenCase));
+        GoldenRender waveform;
+        std::vector<std::array<float, 2 * GOLDEN_NUM_BANDS>> bands;
+        if (! readGoldenWav(goldenPath(goldenCase, ".wav"), waveform)
+            || ! readGoldenBands(goldenPath(goldenCase, ".bands.txt"), bands))
+        {
+            std::fprintf(stderr, "golden: missing or unreadable reference for %s in %s (run with --update-golden)\n",
+                         goldenCase.name, ABYSSVERB_GOLDEN_DIR);
+            passed = false;
+            continue;
+        }
+        if (waveform.left.size() != summary.waveform.left.size() || bands.size() != summary.bands.size())
+        {
+            std::fprintf(stderr, "golden: %s reference has %zu samples / %zu windows, expected %zu / %zu\n",
+                         goldenCase.name, waveform.left.size(), bands.size(),
+                         summary.waveform.left.size(), summary.bands.size());
+            passed = false;
+            continue;
+        }
+
+        bool matches = true;
+        double worstRmsDb = -1000.0, worstPeakDb = -1000.0;
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            double diffRmsDb = 0.0, diffPeakDb = 0.0;
+            size_t peakIndex = 0;
+            if (! goldenWaveformMatches(ch == 0 ? summary.waveform.left : summary.waveform.right,
+                                        ch == 0 ? waveform.left : waveform.right, diffRmsDb, diffPeakDb, peakIndex))
+            {
+                std::fprintf(stderr, "golden: %s: waveform %s differs: difference rms %.1f dB (tolerance %.1f dB), "
+                                     "peak %.1f dBFS at %.3f s (tolerance %.1f dBFS)\n",
+                             goldenCase.name, ch == 0 ? "L" : "R", diffRmsDb, GOLDEN_DIFF_RMS_TOLERANCE_DB, diffPeakDb,
+                             static_cast<double>(peakIndex * GOLDEN_DECIMATION) / GOLDEN_SAMPLE_RATE,
+                             GOLDEN_DIFF_PEAK_TOLERANCE_DB);
+                matches = false;
+            }
+            worstRmsDb = std::max(worstRmsDb, diffRmsDb);
+            worstPeakDb = std::max(worstPeakDb, diffPeakDb);
+        }
+
+        double maxBandError = 0.0;
+        size_t worstWindow = 0, worstBand = 0;
+        for (size_t w = 0; w < bands.size(); ++w)
+            for (size_t k = 0; k < bands[w].size(); ++k)
+            {
+                const double error = std::abs(static_cast<double>(summary.bands[w][k]) - bands[w][k]);
+                if (error > maxBandError)
+                {
+                    maxBandError = error;
+                    worstWindow = w;
+                    worstBand = k;
+                }
+            }
+        if (maxBandError > GOLDEN_BAND_TOLERANCE_DB)
+        {
+            const auto band = worstBand % GOLDEN_NUM_BANDS;
+            std::fprintf(stderr, "golden: %s: %s band %g-%g Hz at %.2f s differs by %.3g dB (tolerance %.3g dB)\n",
+                         goldenCase.name, worstBand < GOLDEN_NUM_BANDS ? "L" : "R", GOLDEN_BAND_EDGES_HZ[band],
+                         GOLDEN_BAND_EDGES_HZ[band + 1], static_cast<double>(worstWindow) * GOLDEN_WINDOW_SECONDS,
+                         maxBandError, GOLDEN_BAND_TOLERANCE_DB);
+            matches = false;
+        }
+
+        if (matches)
+            std::printf("golden: %-26s difference rms %.1f dB, peak %.1f dBFS, max band difference %.2g dB\n",
+                        goldenCase.name, worstRmsDb, worstPeakDb, maxBandError);
+        passed = passed && matches;
+    }
+    return passed;
+}
+
+bool updateGolden()
+{
+    bool passed = true;
+    for (const auto& goldenCase : goldenCases())
+    {
+        const auto summary = summarizeGolden(renderGoldenCase(goldenCase));
+        const auto wavPath = goldenPath(goldenCase, ".wav");
+        const auto bandsPath = goldenPath(goldenCase, ".bands.txt");
+        if (! writeGoldenWav(wavPath, summary.waveform) || ! writeGoldenBands(bandsPath, summary.bands))
+        {
+            std::fprintf(stderr, "cannot write the reference for %s in %s\n", goldenCase.name, ABYSSVERB_GOLDEN_DIR);
+            passed = false;
+        }
+        else
+            std::printf("updated %s, %s\n", wavPath.c_str(), bandsPath.c_str());
+    }
+    return passed;
+}
+
+//==============================================================================
+const TestCase testCases[] = {
+    { "fdn-reference", fdnMatchesReference },
+    { "soft-clip", softClipMatchesReference },
+    { "golden", goldenMatchesReference },
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2 && std::strcmp(argv[1], "--update-golden") == 0)
+        return updateGolden() ? 0 : 1;
+
+    bool passed = true;
+    bool found = argc < 2;
+    for (const auto& test : testCases)
+    {
+        if (argc >= 2 && std::strcmp(argv[1], test.name) != 0)
+            continue;
+        found = true;
+        if (! test.run())
+        {
+            std::fprintf(stderr, "FAILED: %s\n", test.name);
+            passed = false;
+        }
+    }
+
+    if (! found)
+    {
+        std::fprintf(stderr, "unknown test: %s\n", argv[1]);
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,627 @@
+//==============================================================================
+// abyssverb-render — AbyssVerb エンジンによるオフライン一括レンダー
+//
+// WAV/FLAC/AIFF を固定長ブロックでストリーミング処理し（ファイル全体は読み込まない）、
+// 入力の終わりからエンジンのテール長ぶん残響を書き出す。
+// パラメーターと乱数シードはプラグインの状態XML（getStateInformation と同じ形式）または
+// --set / --seeds / --interpolation / --ir で指定。複数ファイルはワーカースレッドで並列に処理する
+//
+// --golden <dir> は組み込みのバイオリン風テスト信号を固定の設定でレンダーし、
+// 保存済みの参照ファイルと RMS / ピーク誤差で比較する（--update で参照を作り直す）。
+// 最適化の前後で出力が変わっていないことをサンプル単位で確かめる時に使う
+// （リポジトリにある参照との比較は ctest の golden。同じケースを間引いた波形の差分と帯域レベルで比べる）
+//
+// ABYSSVERB_PROFILING ビルドでは --profile csv|json で、出力ファイルの隣に
+// ブロックごとの段別時間（CSV）または負荷の集計（JSON）を書き出す
+//==============================================================================
+#include <JuceHeader.h>
+#include "dsp/AbyssVerbEngine.h"
+#include "dsp/GoldenCases.h"
+#include "ImpulseResponseLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct RenderOptions
+{
+    ParamSnapshot params = ParamSnapshot::defaults();
+    juce::uint32 seedLeft = AbyssVerbEngine::DEFAULT_SEED_LEFT;
+    juce::uint32 seedRight = AbyssVerbEngine::DEFAULT_SEED_RIGHT;
+    InterpolationQuality interpolation = InterpolationQuality::hermite;
+    juce::File irFile;              // 初期反射の IR（未指定なら初期反射なし）
+    ImpulseResponse impulseResponse;
+    juce::File outputDir;           // 未指定なら入力と同じフォルダ
+    juce::String suffix = "_abyss";
+    juce::String format;            // 未指定なら入力と同じ形式（wav / flac / aiff）
+    int bitsPerSample = 0;          // 0 なら入力と同じ（出力形式が対応していれば）
+    int blockSize = 8192;
+    double tailSeconds = -1.0;      // 負ならエンジンのテール長
+    int jobs = 0;                   // 0 なら論理コア数
+    bool overwrite = false;
+    bool parallelChannels = false;  // ファイル内でもL/Rを並列に処理する（ファイル数がコア数より少ない時向け）
+#if ABYSSVERB_PROFILING
+    juce::String profileFormat;     // "csv" / "json"。空なら書き出さない
+#endif
+};
+
+std::mutex logMutex;
+
+void log(const juce::String& message)
+{
+    const std::lock_guard<std::mutex> lock(logMutex);
+    std::cout << message << std::endl;
+}
+
+//==============================================================================
+// パラメーター
+//==============================================================================
+bool setParameter(ParamSnapshot& params, const juce::String& id, float value)
+{
+    for (const auto& spec : paramSpecs)
+        if (id == spec.id)
+        {
+            params[spec.param] = juce::jlimit(spec.minValue, spec.maxValue, value);
+            return true;
+        }
+    return false;
+}
+
+// "left,right" 形式のシード指定
+bool parseSeeds(const juce::String& text, RenderOptions& options)
+{
+    const auto left = text.upToFirstOccurrenceOf(",", false, false).trim();
+    const auto right = text.fromFirstOccurrenceOf(",", false, false).trim();
+    if (! left.containsOnly("0123456789") || ! right.containsOnly("0123456789")
+        || left.isEmpty() || right.isEmpty())
+        return false;
+
+    options.seedLeft = static_cast<juce::uint32>(left.getLargeIntValue());
+    options.seedRight = static_cast<juce::uint32>(right.getLargeIntValue());
+    return true;
+}
+
+// プラグインの状態ファイルを読む。XMLそのもの、または copyXmlToBinary の
+// バイナリ形式（マジックナンバー + 長さ + XML文字列）のどちらでもよい
+bool loadStateFile(const juce::File& file, RenderOptions& options, juce::String& error)
+{
+    juce::MemoryBlock data;
+    if (! file.loadFileAsData(data))
+    {
+        error = "cannot read " + file.getFullPathName();
+        return false;
+    }
+
+    juce::String text;
+    constexpr juce::uint32 binaryXmlMagic = 0x21324356;
+    if (data.getSize() > 8 && juce::ByteOrder::littleEndianInt(data.getData()) == binaryXmlMagic)
+    {
+        const auto length = static_cast<size_t>(juce::ByteOrder::littleEndianInt(data.begin() + 4));
+        text = juce::String::fromUTF8(data.begin() + 8, static_cast<int>(juce::jmin(length, data.getSize() - 8)));
+    }
+    else
+    {
+        text = data.toString();
+    }
+
+    const auto xml = juce::parseXML(text);
+    if (xml == nullptr)
+    {
+        error = file.getFileName() + " is not a valid AbyssVerb state";
+        return false;
+    }
+
+    // apvts の状態: <Parameters><PARAM id="..." value="..."/>...</Parameters>
+    int found = 0;
+    for (auto* param : xml->getChildWithTagNameIterator("PARAM"))
+        if (param->hasAttribute("value")
+            && setParameter(options.params, param->getStringAttribute("id"),
+                            static_cast<float>(param->getDoubleAttribute("value"))))
+            ++found;
+
+    if (found == 0)
+    {
+        error = file.getFileName() + " contains no AbyssVerb parameters";
+        return false;
+    }
+
+    // 乱数シードはルート要素のプロパティ（古い状態には無いので既定値のまま）
+    if (xml->hasAttribute("seedLeft"))
+        options.seedLeft = static_cast<juce::uint32>(xml->getStringAttribute("seedLeft").getLargeIntValue());
+    if (xml->hasAttribute("seedRight"))
+        options.seedRight = static_cast<juce::uint32>(xml->getStringAttribute("seedRight").getLargeIntValue());
+    if (xml->hasAttribute("interpolation")
+        && ! FractionalDelay::qualityFromName(xml->getStringAttribute("interpolation").toRawUTF8(), options.interpolation))
+    {
+        error = file.getFileName() + " has an unknown interpolation '" + xml->getStringAttribute("interpolation") + "'";
+        return false;
+    }
+    if (juce::File::isAbsolutePath(xml->getStringAttribute("earlyReflectionsIR")))
+        options.irFile = juce::File(xml->getStringAttribute("earlyReflectionsIR"));
+    return true;
+}
+
+//==============================================================================
+// 1ファイルのレンダー
+//==============================================================================
+bool renderFile(const juce::File& input, const RenderOptions& options, juce::String& error)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+    if (reader == nullptr)
+    {
+        error = "unsupported or unreadable audio file";
+        return false;
+    }
+
+    const auto extension = options.format.isNotEmpty() ? "." + options.format.trimCharactersAtStart(".")
+                                                       : input.getFileExtension();
+    auto* outputFormat = formatManager.findFormatForFileExtension(extension);
+    if (outputFormat == nullptr)
+    {
+        error = "no writer for " + extension;
+        return false;
+    }
+
+    const auto outputDir = options.outputDir == juce::File() ? input.getParentDirectory() : options.outputDir;
+    const auto output = outputDir.getChildFile(input.getFileNameWithoutExtension() + options.suffix + extension);
+    if (output.existsAsFile() && ! options.overwrite)
+    {
+        error = output.getFullPathName() + " already exists (use --overwrite)";
+        return false;
+    }
+
+    // 出力形式が対応するビット深度のうち、希望値以下で最大のもの
+    const int wantedBits = options.bitsPerSample > 0 ? options.bitsPerSample
+                                                     : static_cast<int>(reader->bitsPerSample);
+    int bitsPerSample = 0;
+    for (int bits : outputFormat->getPossibleBitDepths())
+        if (bits <= wantedBits && bits > bitsPerSample)
+            bitsPerSample = bits;
+    if (bitsPerSample == 0)
+        bitsPerSample = outputFormat->getPossibleBitDepths().getFirst();
+
+    output.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(output.createOutputStream());
+    if (stream == nullptr)
+    {
+        error = "cannot write " + output.getFullPathName();
+        return false;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        outputFormat->createWriterFor(stream.get(), reader->sampleRate, 2,
+                                      bitsPerSample, reader->metadataValues, 0));
+    if (writer == nullptr)
+    {
+        error = "cannot create " + outputFormat->getFormatName() + " writer";
+        return false;
+    }
+    stream.release(); // writer が所有する
+
+    // エンジンはファイルのサンプルレートで準備。ブロックバッファ以外は確保しない
+    const int blockSize = options.blockSize;
+    auto engine = std::make_unique<AbyssVerbEngine>();
+    engine->setRandomSeeds(options.seedLeft, options.seedRight);
+    engine->setInterpolationQuality(options.interpolation);
+    engine->setEarlyReflectionsImpulseResponse(options.impulseResponse);
+    engine->prepare(reader->sampleRate, blockSize, options.params);
+    engine->setParallelChannels(options.parallelChannels);
+
+    const double tailSeconds = options.tailSeconds >= 0.0 ? options.tailSeconds
+                                                          : engine->getTailLengthSeconds(options.params);
+    const auto inputLength = reader->lengthInSamples;
+    const auto totalLength = inputLength + static_cast<juce::int64>(std::ceil(tailSeconds * reader->sampleRate));
+    const bool monoInput = reader->numChannels < 2;
+
+#if ABYSSVERB_PROFILING
+    // 負荷のダンプ: CSV はブロックごとに追記、JSON は最後に集計を1つ
+    ProfileStatistics profile;
+    ProfileFrame frame;
+    long long profileBlock = 0;
+    std::unique_ptr<juce::FileOutputStream> profileStream;
+    if (options.profileFormat.isNotEmpty())
+    {
+        const auto profileFile = outputDir.getChildFile(output.getFileNameWithoutExtension()
+                                                        + ".profile." + options.profileFormat);
+        profileFile.deleteFile();
+        profileStream = profileFile.createOutputStream();
+        if (profileStream == nullptr)
+        {
+            error = "cannot write " + profileFile.getFullPathName();
+            writer.reset();
+            output.deleteFile();
+            return false;
+        }
+        if (options.profileFormat == "csv")
+            profileStream->writeText(ProfileStatistics::csvHeader(), false, false, nullptr);
+    }
+#endif
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (juce::int64 pos = 0; pos < totalLength; pos += blockSize)
+    {
+        const int numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, totalLength - pos));
+        buffer.clear();
+
+        // 入力の残り（テール区間は無音）
+        if (pos < inputLength)
+        {
+            const int numToRead = static_cast<int>(juce::jmin<juce::int64>(numSamples, inputLength - pos));
+            if (! reader->read(&buffer, 0, numToRead, pos, true, ! monoInput))
+            {
+                error = "read error at sample " + juce::String(pos);
+                writer.reset();
+                output.deleteFile();
+                return false;
+            }
+        }
+
+        auto* left = buffer.getWritePointer(0);
+        auto* right = buffer.getWritePointer(1);
+        engine->process(left, monoInput ? nullptr : right, left, right, numSamples, options.params);
+
+#if ABYSSVERB_PROFILING
+        while (engine->popProfileFrame(frame))
+        {
+            profile.add(frame);
+            if (profileStream != nullptr && options.profileFormat == "csv")
+                profileStream->writeText(ProfileStatistics::csvRow(profileBlock, frame), false, false, nullptr);
+            ++profileBlock;
+        }
+#endif
+
+        if (! writer->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+        {
+            error = "write error at sample " + juce::String(pos);
+            writer.reset();
+            output.deleteFile();
+            return false;
+        }
+    }
+
+    const double seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    const double audioSeconds = static_cast<double>(totalLength) / reader->sampleRate;
+    juce::String summaryText;
+#if ABYSSVERB_PROFILING
+    const auto summary = profile.summarize();
+    if (profileStream != nullptr && options.profileFormat == "json")
+        profileStream->writeText(ProfileStatistics::toJson(summary) + "\n", false, false, nullptr);
+    summaryText = ", dsp load p99 " + juce::String(summary.total.p99 * 100.0, 2) + "% max "
+                + juce::String(summary.total.max * 100.0, 2) + "%";
+#endif
+    log(input.getFileName() + " -> " + output.getFullPathName()
+        + " (" + juce::String(audioSeconds, 1) + " s audio in " + juce::String(seconds, 2)
+        + " s, " + juce::String(audioSeconds / juce::jmax(seconds, 1.0e-6), 1) + "x realtime" + summaryText + ")");
+    return true;
+}
+
+//==============================================================================
+// ゴールデン比較
+//==============================================================================
+// 信号とケースは dsp/GoldenCases.h（AbyssVerbTests の golden と共通）
+juce::AudioBuffer<float> renderGoldenAudio(const GoldenCase& goldenCase)
+{
+    const auto render = renderGoldenCase(goldenCase);
+    const auto length = static_cast<int>(render.left.size());
+    juce::AudioBuffer<float> result(2, length);
+    result.copyFrom(0, 0, render.left.data(), length);
+    result.copyFrom(1, 0, render.right.data(), length);
+    return result;
+}
+
+bool writeGolden(const juce::File& file, const juce::AudioBuffer<float>& audio, juce::String& error)
+{
+    file.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(file.createOutputStream());
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        stream != nullptr ? wav.createWriterFor(stream.get(), GOLDEN_SAMPLE_RATE, 2, 32, {}, 0) : nullptr);
+    if (writer == nullptr)
+    {
+        error = "cannot write " + file.getFullPathName();
+        return false;
+    }
+    stream.release(); // writer が所有する
+    return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+}
+
+// 参照との差を 参照RMS比の RMS 誤差 [dB] と ピーク誤差 [dBFS] で評価する
+bool compareGolden(const juce::File& file, const juce::AudioBuffer<float>& audio,
+                   double toleranceRmsDb, double tolerancePeakDb, juce::String& report)
+{
+    if (! file.existsAsFile())
+    {
+        report = "missing reference " + file.getFullPathName() + " (run with --update)";
+        return false;
+    }
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+    if (reader == nullptr)
+    {
+        report = "cannot read " + file.getFullPathName();
+        return false;
+    }
+    if (reader->numChannels != 2 || reader->lengthInSamples != audio.getNumSamples())
+    {
+        report = "reference has a different layout or length";
+        return false;
+    }
+
+    juce::AudioBuffer<float> reference(2, audio.getNumSamples());
+    reader->read(&reference, 0, audio.getNumSamples(), 0, true, true);
+
+    double errorEnergy = 0.0, referenceEnergy = 0.0, peakError = 0.0;
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+        {
+            const double ref = reference.getSample(ch, i);
+            const double diff = audio.getSample(ch, i) - ref;
+            errorEnergy += diff * diff;
+            referenceEnergy += ref * ref;
+            peakError = std::max(peakError, std::abs(diff));
+        }
+
+    const auto toDb = [](double ratio) { return ratio > 0.0 ? 10.0 * std::log10(ratio) : -300.0; };
+    const double rmsDb = toDb(errorEnergy / std::max(referenceEnergy, 1.0e-30));
+    const double peakDb = 2.0 * toDb(peakError);
+    report = "rms error " + juce::String(rmsDb, 1) + " dB, peak error " + juce::String(peakDb, 1) + " dBFS";
+    return rmsDb <= toleranceRmsDb && peakDb <= tolerancePeakDb;
+}
+
+int runGolden(const juce::StringArray& args)
+{
+    juce::File directory;
+    bool update = false;
+    double toleranceRmsDb = -90.0, tolerancePeakDb = -80.0;
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+        if (arg == "--update")                              update = true;
+        else if (arg == "--golden" && hasValue)             directory = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+        else if (arg == "--tolerance-rms" && hasValue)      toleranceRmsDb = args[++i].getDoubleValue();
+        else if (arg == "--tolerance-peak" && hasValue)     tolerancePeakDb = args[++i].getDoubleValue();
+        else
+        {
+            std::cerr << "unknown or incomplete golden option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (directory == juce::File() || (update && ! directory.createDirectory()))
+    {
+        std::cerr << "invalid golden directory\n";
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& goldenCase : goldenCases())
+    {
+        const auto file = directory.getChildFile(juce::String(goldenCase.name) + ".wav");
+        const auto audio = renderGoldenAudio(goldenCase);
+
+        juce::String report;
+        const bool ok = update ? writeGolden(file, audio, report)
+                               : compareGolden(file, audio, toleranceRmsDb, tolerancePeakDb, report);
+        if (! ok)
+            ++failures;
+        log(juce::String(ok ? (update ? "updated " : "ok      ") : "FAILED  ")
+            + juce::String(goldenCase.name).paddedRight(' ', 26) + report);
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+//==============================================================================
+// コマンドライン
+//==============================================================================
+void printUsage()
+{
+    std::cout << "usage: abyssverb-render [options] <input files...>\n"
+                 "  --state <file>        plugin state (XML or getStateInformation binary)\n"
+                 "  --set <id>=<value>    set a parameter, may be repeated (applied after --state)\n"
+                 "  --seeds <left>,<right>  vanish random seeds (default: from --state, else built-in)\n"
+                 "  --interpolation <linear|hermite|lagrange|sinc>  modulated delay reads (default: from --state, else hermite)\n"
+                 "  --ir <file>           early reflections impulse response (default: from --state, else none)\n"
+                 "  --out-dir <dir>       output folder (default: next to each input)\n"
+                 "  --suffix <text>       output file name suffix (default: _abyss)\n"
+                 "  --format <wav|flac|aiff>  output format (default: same as input)\n"
+                 "  --bits <n>            output bit depth (default: same as input)\n"
+                 "  --tail <seconds>      tail length after the input ends (default: engine tail length)\n"
+                 "  --block-size <n>      processing block size (default: 8192)\n"
+                 "  --jobs <n>            files rendered in parallel (default: number of cores)\n"
+                 "  --overwrite           replace existing output files\n"
+                 "  --parallel-channels   also split L/R of each file across two threads\n"
+                 "  --list-params         print parameter ids and ranges\n"
+#if ABYSSVERB_PROFILING
+                 "  --profile <csv|json>  write per-block stage timings or a load summary next to each output\n"
+#endif
+                 "\n"
+                 "usage: abyssverb-render --golden <dir> [--update] [--tolerance-rms <dB>] [--tolerance-peak <dBFS>]\n"
+                 "  renders built-in violin test signals and compares them with <dir>/*.wav\n"
+                 "  (defaults: rms error <= -90 dB relative, peak error <= -80 dBFS)\n";
+}
+
+void printParameters()
+{
+    for (const auto& spec : paramSpecs)
+        std::cout << juce::String(spec.id).paddedRight(' ', 18) << spec.minValue << " .. " << spec.maxValue
+                  << " (default " << spec.defaultValue << ")\n";
+}
+
+bool parseArguments(const juce::StringArray& args, RenderOptions& options, juce::Array<juce::File>& inputs)
+{
+    juce::StringArray assignments;
+    juce::File stateFile;
+    juce::String seedText, interpolationText;
+    juce::File irFile;
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const auto needsValue = [&]() { return i + 1 < args.size(); };
+
+        if (arg == "--overwrite")
+            options.overwrite = true;
+        else if (arg == "--parallel-channels")
+            options.parallelChannels = true;
+        else if (arg.startsWith("--") && ! needsValue())
+        {
+            std::cerr << "missing value for " << arg << "\n";
+            return false;
+        }
+        else if (arg == "--state")      stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+        else if (arg == "--set")        assignments.add(args[++i]);
+        else if (arg == "--seeds")      seedText = args[++i];
+        else if (arg == "--interpolation") interpolationText = args[++i];
+        else if (arg == "--ir")         irFile = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+        else if (arg == "--out-dir")    options.outputDir = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+        else if (arg == "--suffix")     options.suffix = args[++i];
+        else if (arg == "--format")     options.format = args[++i].toLowerCase();
+        else if (arg == "--bits")       options.bitsPerSample = args[++i].getIntValue();
+        else if (arg == "--tail")       options.tailSeconds = args[++i].getDoubleValue();
+        else if (arg == "--block-size") options.blockSize = juce::jmax(16, args[++i].getIntValue());
+        else if (arg == "--jobs")       options.jobs = juce::jmax(0, args[++i].getIntValue());
+#if ABYSSVERB_PROFILING
+        else if (arg == "--profile")    options.profileFormat = args[++i].toLowerCase();
+#endif
+        else if (arg.startsWith("--"))
+        {
+            std::cerr << "unknown option " << arg << "\n";
+            return false;
+        }
+        else
+            inputs.add(juce::File::getCurrentWorkingDirectory().getChildFile(arg));
+    }
+
+    if (stateFile != juce::File())
+    {
+        juce::String error;
+        if (! loadStateFile(stateFile, options, error))
+        {
+            std::cerr << error << "\n";
+            return false;
+        }
+    }
+
+    if (seedText.isNotEmpty() && ! parseSeeds(seedText, options))
+    {
+        std::cerr << "invalid --seeds '" << seedText << "' (expected <left>,<right>)\n";
+        return false;
+    }
+
+    if (interpolationText.isNotEmpty()
+        && ! FractionalDelay::qualityFromName(interpolationText.toLowerCase().toRawUTF8(), options.interpolation))
+    {
+        std::cerr << "invalid --interpolation '" << interpolationText << "' (expected linear, hermite, lagrange or sinc)\n";
+        return false;
+    }
+
+    // IR は全ファイルで共通なので一度だけ読む
+    if (irFile != juce::File())
+        options.irFile = irFile;
+    if (options.irFile != juce::File())
+    {
+        juce::String error;
+        if (! ImpulseResponseLoader::readFile(options.irFile, options.impulseResponse, error))
+        {
+            std::cerr << error << "\n";
+            return false;
+        }
+    }
+
+    for (const auto& assignment : assignments)
+    {
+        const auto id = assignment.upToFirstOccurrenceOf("=", false, false).trim();
+        const auto value = assignment.fromFirstOccurrenceOf("=", false, false).trim();
+        if (value.isEmpty() || ! setParameter(options.params, id, value.getFloatValue()))
+        {
+            std::cerr << "invalid parameter assignment '" << assignment << "' (see --list-params)\n";
+            return false;
+        }
+    }
+
+#if ABYSSVERB_PROFILING
+    if (options.profileFormat.isNotEmpty() && options.profileFormat != "csv" && options.profileFormat != "json")
+    {
+        std::cerr << "invalid --profile '" << options.profileFormat << "' (expected csv or json)\n";
+        return false;
+    }
+#endif
+
+    if (options.outputDir != juce::File() && ! options.outputDir.createDirectory())
+    {
+        std::cerr << "cannot create " << options.outputDir.getFullPathName() << "\n";
+        return false;
+    }
+
+    return ! inputs.isEmpty();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+
+    if (args.contains("--list-params"))
+    {
+        printParameters();
+        return 0;
+    }
+
+    if (args.contains("--golden"))
+        return runGolden(args);
+
+    RenderOptions options;
+    juce::Array<juce::File> inputs;
+    if (args.contains("--help") || ! parseArguments(args, options, inputs))
+    {
+        printUsage();
+        return 1;
+    }
+
+    // ファイル単位で並列化: 各ワーカーが次の未処理ファイルを取りに行く
+    const int numJobs = juce::jlimit(1, inputs.size(),
+                                     options.jobs > 0 ? options.jobs : juce::SystemStats::getNumCpus());
+    std::atomic<int> nextInput { 0 };
+    std::atomic<int> failures { 0 };
+
+    auto worker = [&]
+    {
+        for (int i = nextInput++; i < inputs.size(); i = nextInput++)
+        {
+            juce::String error;
+            if (! renderFile(inputs[i], options, error))
+            {
+                log("error: " + inputs[i].getFullPathName() + ": " + error);
+                ++failures;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < numJobs; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (auto& thread : workers)
+        thread.join();
+
+    log(juce::String(inputs.size() - failures.load()) + " of " + juce::String(inputs.size()) + " files rendered");
+    return failures.load() == 0 ? 0 : 1;
+}